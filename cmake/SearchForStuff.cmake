@@ -84,6 +84,7 @@ if(NOT LIBLZMA_FOUND)
    set(LIBLZMA_FOUND 1)
    add_definitions(-DLZMA_API_STATIC)
    set(LIBLZMA_LIBRARIES lzma)
+   set(LIBLZMA_INCLUDE_DIRS ${CMAKE_SOURCE_DIR}/3rdparty/xz/xz/src/liblzma/api)
    add_subdirectory(${CMAKE_SOURCE_DIR}/3rdparty/xz)
 endif()
 
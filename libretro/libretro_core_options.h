@@ -42,6 +42,66 @@ struct retro_core_option_definition option_defs[] = {
 	},
 	"disabled"},
 
+	{BOOL_PCSX2_OPT_IOP_HLE,
+	"System: IOP Module HLE",
+	"A hack that runs native versions of the IOP sysclib memory routines (memcpy, memset...) instead of emulating the module code. Lowers IOP overhead in games with heavy SIF traffic. (Content restart required)",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
+	{BOOL_PCSX2_OPT_VU0_THREAD,
+	"System: Threaded VU0 Micro Mode",
+	"A hack that runs VU0 micro programs on their own thread, the EE only waits for them when it accesses VU0 registers. Speeds up games that rely on VU0 micro mode for physics, but some games depend on the exact timing between the two units. (Content restart required)",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
+	{BOOL_PCSX2_OPT_FRAME_STEP,
+	"System: Frame-Stepped Execution",
+	"Lets the EE run only one frame ahead of the frontend, so every call to the core emulates exactly one frame. Reduces input latency and keeps pacing stable at the cost of some parallelism between the EE and GS threads.",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
+	{BOOL_PCSX2_OPT_GUEST_PROFILER,
+	"System: Guest Profiler",
+	"Samples the EE and IOP program counters while the game runs. Disabling it again, or closing the content, writes a flat, recompiled block and call-stack profile of the game's functions to the pcsx2 save folder. For development only, costs some speed.",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
+	{BOOL_PCSX2_OPT_REC_CACHE_STATS,
+	"System: Recompiler Cache Statistics",
+	"Writes the recompiler cache usage, full cache flushes and the most invalidated EE memory pages to the pcsx2 save folder each time this is enabled, and again when the content is closed. Helps telling whether a stutter is a cache flush.",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
+	{BOOL_PCSX2_OPT_CONVERT_XZ,
+	"System: Compress Disc Image",
+	"Converts the loaded disc image in the background to a block-indexed .xz image in the pcsx2 save folder, which loads like any other image and is usually smaller than CSO. Disabling it, or closing the content, cancels an unfinished conversion.",
+	{
+		{"disabled", NULL},
+		{"enabled", NULL},
+		{NULL, NULL},
+	},
+	"disabled"},
+
 	{BOOL_PCSX2_OPT_FASTBOOT,
 	"System: Fast Boot",
 	"Bypass the initial BIOS logo. (Content restart required)",
@@ -13,6 +13,7 @@
 #include <libretro.h>
 #include <libretro_core_options.h>
 #include <string>
+#include <atomic>
 #include <thread>
 #include <wx/textfile.h>
 #include <wx/stdpaths.h>
@@ -33,6 +34,10 @@
 
 
 #include "MTVU.h"
+#include "Elfheader.h"
+#include "DebugTools/GuestProfiler.h"
+#include "System/RecTypes.h"
+#include "CDVD/IsoFileFormats.h"
 
 #ifdef PERF_TEST
 static struct retro_perf_callback perf_cb;
@@ -58,6 +63,10 @@ static bool init_failed = false;
 int option_upscale_mult = 1;
 int option_pad_left_deadzone = 0;
 int option_pad_right_deadzone = 0;
+static bool option_frame_step = false;
+static bool option_rec_cache_stats = false;
+static std::thread xz_convert_thread;
+static std::atomic<bool> xz_convert_cancel(false);
 bool hack_fb_conversion = false;
 bool hack_AutoFlush = false;
 
@@ -372,6 +381,8 @@ void retro_init(void)
 		g_Conf->EnablePresets = true;
 		g_Conf->EmuOptions.EnableIPC = false;
 		g_Conf->EmuOptions.Speedhacks.fastCDVD  = option_value(BOOL_PCSX2_OPT_FASTCDVD, KeyOptionBool::return_type);
+		g_Conf->EmuOptions.Speedhacks.IopHLE    = option_value(BOOL_PCSX2_OPT_IOP_HLE, KeyOptionBool::return_type);
+		g_Conf->EmuOptions.Speedhacks.vu0Thread = option_value(BOOL_PCSX2_OPT_VU0_THREAD, KeyOptionBool::return_type);
 
 		g_Conf->EmuOptions.EnableNointerlacingPatches = (option_value(INT_PCSX2_OPT_DEINTERLACING_MODE, KeyOptionInt::return_type) == -1);
 		g_Conf->EmuOptions.Enable60fpsPatches = (option_value(BOOL_PCSX2_OPT_ENABLE_60FPS_PATCHES, KeyOptionBool::return_type));
@@ -401,6 +412,7 @@ void retro_init(void)
 
 		option_pad_left_deadzone = option_value(INT_PCSX2_OPT_GAMEPAD_L_DEADZONE, KeyOptionInt::return_type);
 		option_pad_right_deadzone = option_value(INT_PCSX2_OPT_GAMEPAD_R_DEADZONE, KeyOptionInt::return_type);
+		option_frame_step = option_value(BOOL_PCSX2_OPT_FRAME_STEP, KeyOptionBool::return_type);
 
 		static retro_disk_control_ext_callback disk_control = {
 			DiskControl::set_eject_state,
@@ -429,6 +441,7 @@ void retro_deinit(void)
 	main thread tries to call vu1Thread.Cancel() within pcsx2's destructor
 	and it gets stuck waiting for a mutex that will never unlock */
 	vu1Thread.WaitVU();
+	vu0Thread.WaitVU();
 	//vu1Thread.Cancel();
 
 	pcsx2->CleanupOnExit();
@@ -456,7 +469,7 @@ void retro_get_system_info(retro_system_info* info)
 #endif
 
 	info->library_name = "pcsx2 (alpha)";
-	info->valid_extensions = "elf|iso|ciso|chd|cso|cue|bin|m3u";
+	info->valid_extensions = "elf|iso|ciso|chd|cso|xz|cue|bin|m3u";
 	info->need_fullpath = true;
 	info->block_extract = true;
 }
@@ -609,6 +622,144 @@ read_m3u_file(const wxFileName& m3u_file)
 	return result;
 }
 
+// Starts sampling when enabled, and writes the profile to the save folder when disabled.
+static void guest_profiler_enable(bool enable)
+{
+	if (enable == GuestProfiler::IsRunning())
+		return;
+
+	if (enable)
+	{
+		GuestProfiler::Reset();
+		GuestProfiler::Start();
+		log_cb(RETRO_LOG_INFO, "Guest profiler started\n");
+		return;
+	}
+
+	GuestProfiler::Stop();
+
+	std::string path = wxFileName(save_dir_root.GetPath(), wxString::Format("profile_%08X.txt", ElfCRC)).GetFullPath().ToStdString();
+	if (GuestProfiler::Dump(path.c_str()))
+		log_cb(RETRO_LOG_INFO, "Guest profile written to %s\n", path.c_str());
+	else
+		log_cb(RETRO_LOG_ERROR, "Could not write guest profile to %s\n", path.c_str());
+}
+
+static void rec_cache_stats_dump()
+{
+	std::string path = wxFileName(save_dir_root.GetPath(), wxString::Format("reccache_%08X.txt", ElfCRC)).GetFullPath().ToStdString();
+	if (RecCacheStats::Dump(path.c_str()))
+		log_cb(RETRO_LOG_INFO, "Recompiler cache statistics written to %s\n", path.c_str());
+	else
+		log_cb(RETRO_LOG_ERROR, "Could not write recompiler cache statistics to %s\n", path.c_str());
+}
+
+// Dumps on every switch from disabled to enabled.
+static void rec_cache_stats_option(bool enable)
+{
+	if (enable && !option_rec_cache_stats)
+		rec_cache_stats_dump();
+	option_rec_cache_stats = enable;
+}
+
+static void xz_convert_run(wxString src_path, wxString dst_path)
+{
+	// Written under a temporary name, so that a cancelled conversion leaves nothing behind
+	wxString tmp_path = dst_path + L".tmp";
+	bool done = false;
+
+	try
+	{
+		InputIsoFile src;
+		src.Open(src_path);
+
+		OutputIsoFile dst;
+		dst.Create(tmp_path, OutputIsoFile::XzVersion);
+		done = dst.WriteImage(src, &xz_convert_cancel);
+		dst.Close();
+	}
+	catch (BaseException& ex)
+	{
+		log_cb(RETRO_LOG_ERROR, "%s\n", WX_STR(ex.FormatDiagnosticMessage()));
+		done = false;
+	}
+
+	if (done && wxRenameFile(tmp_path, dst_path, true))
+	{
+		log_cb(RETRO_LOG_INFO, "Disc image compressed to %s\n", WX_STR(dst_path));
+		return;
+	}
+
+	wxRemoveFile(tmp_path);
+	if (!xz_convert_cancel)
+		log_cb(RETRO_LOG_ERROR, "Could not compress disc image to %s\n", WX_STR(dst_path));
+}
+
+static void xz_convert_stop()
+{
+	if (!xz_convert_thread.joinable())
+		return;
+
+	xz_convert_cancel = true;
+	xz_convert_thread.join();
+}
+
+// Converts the current disc image to a block-indexed .xz image in the save folder,
+// unless it is one already or was converted before.
+static void xz_convert_option(bool enable)
+{
+	if (!enable)
+	{
+		xz_convert_stop();
+		return;
+	}
+
+	const wxString& iso = g_Conf->CurrentIso;
+	if (xz_convert_thread.joinable() || iso.IsEmpty() || iso.Lower().EndsWith(L".xz"))
+		return;
+
+	wxString dst_path = wxFileName(save_dir_root.GetPath(), wxFileName(iso).GetName() + L".xz").GetFullPath();
+	if (wxFileName::FileExists(dst_path))
+		return;
+
+	log_cb(RETRO_LOG_INFO, "Compressing disc image to %s in the background\n", WX_STR(dst_path));
+	xz_convert_cancel = false;
+	xz_convert_thread = std::thread(xz_convert_run, iso, dst_path);
+}
+
+#ifdef PERF_TEST
+// Mirrors the recompiler cache statistics into perf counters, so they show up in the
+// frontend's perf log: flush counters hold the time spent flushing in microseconds,
+// usage counters hold the bytes in use as a single "call".
+static void rec_cache_stats_perf_update()
+{
+	static struct retro_perf_counter flushes[RecCache_Count] = {
+		{"ee_rec_cache_flush"}, {"iop_rec_cache_flush"}, {"vu0_rec_cache_flush"}, {"vu1_rec_cache_flush"}};
+	static struct retro_perf_counter usage[RecCache_Count] = {
+		{"ee_rec_cache_used"}, {"iop_rec_cache_used"}, {"vu0_rec_cache_used"}, {"vu1_rec_cache_used"}};
+	static struct retro_perf_counter clears = {"ee_rec_block_clears"};
+
+	for (int i = 0; i < RecCache_Count; i++)
+	{
+		RecCacheStats::CacheInfo info = RecCacheStats::GetCache((RecCacheType)i);
+
+		if (!flushes[i].registered)
+			perf_cb.perf_register(&flushes[i]);
+		flushes[i].total = info.flushMicros;
+		flushes[i].call_cnt = info.fullFlushes;
+
+		if (!usage[i].registered)
+			perf_cb.perf_register(&usage[i]);
+		usage[i].total = info.bytesUsed;
+		usage[i].call_cnt = 1;
+	}
+
+	if (!clears.registered)
+		perf_cb.perf_register(&clears);
+	clears.total = clears.call_cnt = RecCacheStats::GetClears();
+}
+#endif
+
 bool retro_load_game(const struct retro_game_info* game)
 {
 	if (init_failed)
@@ -817,6 +968,9 @@ bool retro_load_game(const struct retro_game_info* game)
 			option_value(BOOL_PCSX2_OPT_GAMEPAD_RUMBLE_ENABLE, KeyOptionBool::return_type),
 			option_value(INT_PCSX2_OPT_GAMEPAD_RUMBLE_FORCE, KeyOptionInt::return_type)
 			);
+	guest_profiler_enable(option_value(BOOL_PCSX2_OPT_GUEST_PROFILER, KeyOptionBool::return_type));
+	option_rec_cache_stats = option_value(BOOL_PCSX2_OPT_REC_CACHE_STATS, KeyOptionBool::return_type);
+	xz_convert_option(option_value(BOOL_PCSX2_OPT_CONVERT_XZ, KeyOptionBool::return_type));
 
 	retro_hw_context_type context_type = RETRO_HW_CONTEXT_OPENGL;
 	const char* option_renderer = option_value(STRING_PCSX2_OPT_RENDERER, KeyOptionString::return_type);
@@ -842,6 +996,12 @@ bool retro_load_game_special(unsigned game_type, const struct retro_game_info* i
 
 void retro_unload_game(void)
 {
+	guest_profiler_enable(false);
+	if (option_rec_cache_stats)
+		rec_cache_stats_dump();
+	RecCacheStats::Reset();
+	xz_convert_stop();
+
 	//	GetMTGS().FinishTaskInThread();
 	//		GetMTGS().CloseGS();
 	GetMTGS().FinishTaskInThread();
@@ -872,7 +1032,10 @@ void retro_run(void)
 		);
 		option_pad_left_deadzone = option_value(INT_PCSX2_OPT_GAMEPAD_L_DEADZONE, KeyOptionInt::return_type);
 		option_pad_right_deadzone = option_value(INT_PCSX2_OPT_GAMEPAD_R_DEADZONE, KeyOptionInt::return_type);
-
+		option_frame_step = option_value(BOOL_PCSX2_OPT_FRAME_STEP, KeyOptionBool::return_type);
+		guest_profiler_enable(option_value(BOOL_PCSX2_OPT_GUEST_PROFILER, KeyOptionBool::return_type));
+		rec_cache_stats_option(option_value(BOOL_PCSX2_OPT_REC_CACHE_STATS, KeyOptionBool::return_type));
+		xz_convert_option(option_value(BOOL_PCSX2_OPT_CONVERT_XZ, KeyOptionBool::return_type));
 	}
 
 	Input::Update();
@@ -880,9 +1043,13 @@ void retro_run(void)
 	RETRO_PERFORMANCE_INIT(pcsx2_run);
 	RETRO_PERFORMANCE_START(pcsx2_run);
 
-	GetMTGS().ExecuteTaskInThread();
+	GetMTGS().StepFrame(option_frame_step);
 
 	RETRO_PERFORMANCE_STOP(pcsx2_run);
+
+#ifdef PERF_TEST
+	rec_cache_stats_perf_update();
+#endif
 }
 
 size_t retro_serialize_size(void)
@@ -3,6 +3,12 @@
 
 #define BOOL_PCSX2_OPT_FASTCDVD			 "pcsx2_fastcdvd"
 #define BOOL_PCSX2_OPT_FASTBOOT			 "pcsx2_fastboot"
+#define BOOL_PCSX2_OPT_IOP_HLE			 "pcsx2_iop_hle"
+#define BOOL_PCSX2_OPT_VU0_THREAD		 "pcsx2_vu0_thread"
+#define BOOL_PCSX2_OPT_FRAME_STEP		 "pcsx2_frame_step"
+#define BOOL_PCSX2_OPT_GUEST_PROFILER		 "pcsx2_guest_profiler"
+#define BOOL_PCSX2_OPT_REC_CACHE_STATS		 "pcsx2_rec_cache_stats"
+#define BOOL_PCSX2_OPT_CONVERT_XZ		 "pcsx2_convert_xz"
 #define BOOL_PCSX2_OPT_ENABLE_WIDESCREEN_PATCHES "pcsx2_enable_widescreen_patches"
 #define BOOL_PCSX2_OPT_ENABLE_60FPS_PATCHES      "pcsx2_enable_60fps_patches"
 #define BOOL_PCSX2_OPT_FRAMESKIP		 "pcsx2_frameskip"
@@ -19,7 +19,6 @@ bool ChdFileReader::Open(const wxString &fileName)
 	  m_filename = fileName;
 
     chd_file *child = NULL;
-    chd_file *parent = NULL;
     chd_header *header = new chd_header;
     chd_header *parent_header = new chd_header;
 
@@ -70,21 +69,15 @@ bool ChdFileReader::Open(const wxString &fileName)
         return false;
     }
 
-		// log_cb(RETRO_LOG_INFO, "chd_opened parent: %d %s\n", chd_depth, static_cast<const char*>(chds[chd_depth]));
-    for (int d = chd_depth-1; d >= 0; d--) {
-      // parent = child;
-      // child = (chd_file**)malloc(sizeof(chd_file*));
-      parent = child;
-      child = NULL;
-      // log_cb(RETRO_LOG_ERROR, "chd_open opening chd: %d %s\n", d, static_cast<const char*>(chds[d]));
-      error = chd_open(static_cast<const char*>(chds[d]), CHD_OPEN_READ, parent, &child);
-      if (error != CHDERR_NONE) {
-		    log_cb(RETRO_LOG_ERROR, "chd_open return error: %s\n", chd_error_string(error));
+    // Worker threads need their own handles on the whole chain
+    chain.assign(chds, chds + chd_depth + 1);
+    chd_close(child);
+
+    error = OpenChain(&ChdFile);
+    if (error != CHDERR_NONE) {
         delete header;
         return false;
-      }
     }
-    ChdFile = child;
     if (chd_read_header(static_cast<const char*>(chds[0]), header) != CHDERR_NONE) {
       log_cb(RETRO_LOG_ERROR, "chd_open chd_read_header error: %s: %s\n", chd_error_string(error), static_cast<const char*>(chds[0]));
       delete header;
@@ -95,34 +88,98 @@ bool ChdFileReader::Open(const wxString &fileName)
     sector_size = header->unitbytes;
     sector_count = header->unitcount;
     sectors_per_hunk = header->hunkbytes / sector_size;
-    hunk_buffer = new u8[header->hunkbytes];
-    current_hunk = -1;
+    hunk_bytes = header->hunkbytes;
+    hunk_count = header->totalhunks;
+
+    StartDecoders();
 
     delete header;
     return true;
 }
 
+// Opens the chain of files from the oldest parent to the image itself.
+// Closing the returned file also closes its parents.
+chd_error ChdFileReader::OpenChain(chd_file **file)
+{
+    chd_file *parent = NULL;
+    chd_file *child = NULL;
+    chd_error error = CHDERR_NONE;
+
+    for (int d = (int)chain.size() - 1; d >= 0; d--) {
+      parent = child;
+      child = NULL;
+      // log_cb(RETRO_LOG_ERROR, "chd_open opening chd: %d %s\n", d, static_cast<const char*>(chain[d]));
+      error = chd_open(static_cast<const char*>(chain[d]), CHD_OPEN_READ, parent, &child);
+      if (error != CHDERR_NONE) {
+        log_cb(RETRO_LOG_ERROR, "chd_open return error: %s\n", chd_error_string(error));
+        // Once libchdr has allocated the child, closing it on failure also
+        // closed the parent; only when the file couldn't be opened is it ours.
+        if (parent != NULL && error == CHDERR_FILE_NOT_FOUND)
+            chd_close(parent);
+        return error;
+      }
+    }
+
+    *file = child;
+    return error;
+}
+
+void ChdFileReader::StartDecoders()
+{
+    uint count = DecodedBlockCache::GetDefaultThreadCount(CHD_MAX_DECODER_THREADS);
+    for (uint i = 0; i < count; i++) {
+        chd_file *file;
+        if (OpenChain(&file) != CHDERR_NONE)
+            break;
+        decoder_files.push_back(file);
+    }
+
+    cache.Open(CHD_HUNK_CACHE_SIZE, hunk_bytes, hunk_count, decoder_files.size(),
+        [this](uint decoder, u32 hunk, u8 *dest) { return DecodeHunk(decoder ? decoder_files[decoder - 1] : ChdFile, hunk, dest); });
+}
+
+void ChdFileReader::StopDecoders()
+{
+    cache.Close();
+
+    for (chd_file *file : decoder_files)
+        chd_close(file);
+    decoder_files.clear();
+}
+
+bool ChdFileReader::DecodeHunk(chd_file *file, u32 hunk, u8 *dest)
+{
+    chd_error error = chd_read(file, hunk, dest);
+    if (error != CHDERR_NONE) {
+        log_cb(RETRO_LOG_ERROR, "chd_read return error: %s\n", chd_error_string(error));
+        return false;
+    }
+    return true;
+}
+
 int ChdFileReader::ReadSync(void *pBuffer, uint sector, uint count)
 {
     u8 *dst = (u8 *) pBuffer;
     u32 hunk = sector / sectors_per_hunk;
     u32 sector_in_hunk = sector % sectors_per_hunk;
-    chd_error error;
 
+    // Get the workers started on the following hunks of this read (and the next ones),
+    // the first one is decoded right away by the reader.
+    cache.Prefetch(hunk + 1, (sector + count - 1) / sectors_per_hunk + CHD_PREFETCH_HUNKS);
+
+    const u8 *hunk_data = NULL;
     for (uint i = 0; i < count; i++) {
-      if (current_hunk != hunk) {
-        error = chd_read(ChdFile, hunk, hunk_buffer);
-        if (error != CHDERR_NONE) {
-            log_cb(RETRO_LOG_ERROR, "chd_read return error: %s\n", chd_error_string(error));
-            // return i * m_blocksize;
-        }
-        current_hunk = hunk;
-      }
-      memcpy(dst + i * m_blocksize, hunk_buffer + sector_in_hunk * sector_size, m_blocksize);
+      if (!hunk_data)
+        hunk_data = cache.Get(hunk);
+      if (hunk_data)
+        memcpy(dst + i * m_blocksize, hunk_data + sector_in_hunk * sector_size, m_blocksize);
+      else
+        memset(dst + i * m_blocksize, 0, m_blocksize);
       sector_in_hunk++;
       if (sector_in_hunk >= sectors_per_hunk) {
         hunk++;
         sector_in_hunk = 0;
+        hunk_data = NULL;
       }
     }
     return m_blocksize * count;
@@ -141,11 +198,9 @@ int ChdFileReader::FinishRead()
 
 void ChdFileReader::Close()
 {
-    if (hunk_buffer != NULL) {
-      //free(hunk_buffer);
-      delete[] hunk_buffer;
-      hunk_buffer = NULL;
-    }
+    cache.LogStats("CHD hunk");
+    StopDecoders();
+
     if (ChdFile != NULL) {
       chd_close(ChdFile);
       ChdFile = NULL;
@@ -169,5 +224,4 @@ u32 ChdFileReader::GetBlockCount() const
 ChdFileReader::ChdFileReader(void)
 {
   ChdFile = NULL;
-  hunk_buffer = NULL;
 };
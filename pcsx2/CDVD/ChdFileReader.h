@@ -1,7 +1,16 @@
 #pragma once
 #include "AsyncFileReader.h"
+#include "DecodedBlockCache.h"
 #include "libchdr/chd.h"
 
+#include <vector>
+
+// Hunks are decoded into a DecodedBlockCache, each worker with its own handle on
+// the chd (and parent) files since libchdr handles can't be shared between threads.
+static const uint CHD_HUNK_CACHE_SIZE = 64;     // decoded hunks kept around
+static const uint CHD_PREFETCH_HUNKS = 4;       // hunks decoded ahead of a read
+static const uint CHD_MAX_DECODER_THREADS = 4;
+
 class ChdFileReader : public AsyncFileReader
 {
     DeclareNoncopyableObject(ChdFileReader);
@@ -24,11 +33,21 @@ public:
     ChdFileReader(void);
 
 private:
+    chd_error OpenChain(chd_file **file);
+    void StartDecoders();
+    void StopDecoders();
+    bool DecodeHunk(chd_file *file, u32 hunk, u8 *dest);
+
     chd_file *ChdFile;
-    u8 *hunk_buffer;
+    std::vector<wxString> chain; // file names, from the image to its oldest parent
     u32 sector_size;
     u32 sector_count;
     u32 sectors_per_hunk;
-    u32 current_hunk;
+    u32 hunk_bytes;
+    u32 hunk_count;
     u32 async_read;
+
+    // Decoded hunks, and the handles of the cache workers (the reader uses ChdFile)
+    DecodedBlockCache cache;
+    std::vector<chd_file *> decoder_files;
 };
\ No newline at end of file
@@ -142,20 +142,6 @@ bool CsoFileReader::InitializeBuffers()
 	// Round up, since part of a frame requires a full frame.
 	u32 numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
 
-	// We might read a bit of alignment too, so be prepared.
-	if (m_frameSize + (1 << m_indexShift) < CSO_READ_BUFFER_SIZE)
-	{
-		m_readBuffer = new u8[CSO_READ_BUFFER_SIZE];
-	}
-	else
-	{
-		m_readBuffer = new u8[m_frameSize + (1 << m_indexShift)];
-	}
-
-	// This is a buffer for the most recently decompressed frame.
-	m_zlibBuffer = new u8[m_frameSize + (1 << m_indexShift)];
-	m_zlibBufferFrame = numFrames;
-
 	const u32 indexSize = numFrames + 1;
 	m_index = new u32[indexSize];
 	if (fread(m_index, sizeof(u32), indexSize, m_src) != indexSize)
@@ -164,11 +150,27 @@ bool CsoFileReader::InitializeBuffers()
 		return false;
 	}
 
-	m_z_stream = new z_stream;
-	m_z_stream->zalloc = Z_NULL;
-	m_z_stream->zfree = Z_NULL;
-	m_z_stream->opaque = Z_NULL;
-	if (inflateInit2(m_z_stream, -15) != Z_OK)
+	return StartDecoders();
+}
+
+bool CsoFileReader::InitDecoder(Decoder* decoder)
+{
+	// We might read a bit of alignment too, so be prepared.
+	const u32 readBufferSize = std::max(CSO_READ_BUFFER_SIZE, m_frameSize + (1 << m_indexShift));
+
+	decoder->src = PX_fopen_rb(m_filename);
+	decoder->readBuffer = new u8[readBufferSize];
+	decoder->stream = new z_stream;
+	decoder->stream->zalloc = Z_NULL;
+	decoder->stream->zfree = Z_NULL;
+	decoder->stream->opaque = Z_NULL;
+	if (inflateInit2(decoder->stream, -15) != Z_OK)
+	{
+		delete decoder->stream;
+		decoder->stream = NULL;
+	}
+
+	if (!decoder->src || !decoder->stream)
 	{
 		log_cb(RETRO_LOG_ERROR, "Unable to initialize zlib for CSO decompression.\n");
 		return false;
@@ -177,8 +179,56 @@ bool CsoFileReader::InitializeBuffers()
 	return true;
 }
 
+void CsoFileReader::FreeDecoder(Decoder* decoder)
+{
+	if (decoder->stream)
+	{
+		inflateEnd(decoder->stream);
+		delete decoder->stream;
+		decoder->stream = NULL;
+	}
+	if (decoder->src)
+	{
+		fclose(decoder->src);
+		decoder->src = NULL;
+	}
+	if (decoder->readBuffer)
+	{
+		delete[] decoder->readBuffer;
+		decoder->readBuffer = NULL;
+	}
+}
+
+bool CsoFileReader::StartDecoders()
+{
+	// One decoder for the frames the reader needs right away, and one per worker
+	const uint threads = DecodedBlockCache::GetDefaultThreadCount(CSO_MAX_DECODER_THREADS);
+	m_decoders.resize(threads + 1);
+	for (Decoder& decoder : m_decoders)
+	{
+		if (!InitDecoder(&decoder))
+			return false;
+	}
+
+	const u32 numFrames = (u32)((m_totalSize + m_frameSize - 1) / m_frameSize);
+	m_frames.Open(CSO_FRAME_CACHE_SIZE, m_frameSize, numFrames, threads,
+		[this](uint decoder, u32 frame, u8* dest) { return DecompressFrame(&m_decoders[decoder], frame, dest); });
+	return true;
+}
+
+void CsoFileReader::StopDecoders()
+{
+	m_frames.Close();
+
+	for (Decoder& decoder : m_decoders)
+		FreeDecoder(&decoder);
+	m_decoders.clear();
+}
+
 void CsoFileReader::Close()
 {
+	StopDecoders();
+
 	m_filename.Empty();
 #if CSO_USE_CHUNKSCACHE
 	m_cache.Clear();
@@ -189,22 +239,7 @@ void CsoFileReader::Close()
 		fclose(m_src);
 		m_src = NULL;
 	}
-	if (m_z_stream)
-	{
-		inflateEnd(m_z_stream);
-		m_z_stream = NULL;
-	}
 
-	if (m_readBuffer)
-	{
-		delete[] m_readBuffer;
-		m_readBuffer = NULL;
-	}
-	if (m_zlibBuffer)
-	{
-		delete[] m_zlibBuffer;
-		m_zlibBuffer = NULL;
-	}
 	if (m_index)
 	{
 		delete[] m_index;
@@ -228,6 +263,14 @@ int CsoFileReader::ReadSync(void* pBuffer, uint sector, uint count)
 	int remaining = count * m_blocksize;
 	int bytes = 0;
 
+	// Get the workers started on the following frames of this read (and the next ones),
+	// the first one is decoded right away by ReadFromFrame.
+	if (pos < m_totalSize)
+	{
+		const u64 end = std::min(pos + remaining, m_totalSize) - 1;
+		m_frames.Prefetch((u32)(pos >> m_frameShift) + 1, (u32)(end >> m_frameShift) + CSO_PREFETCH_FRAMES);
+	}
+
 	while (remaining > 0)
 	{
 		int readBytes;
@@ -275,72 +318,61 @@ int CsoFileReader::ReadFromFrame(u8* dest, u64 pos, int maxBytes)
 	// This is how many bytes we will actually be reading from this frame.
 	const u32 bytes = (u32)(std::min(m_blocksize, static_cast<uint>(m_frameSize - offset)));
 
-	// Grab the index data for the frame we're about to read.
-	const bool compressed = (m_index[frame + 0] & 0x80000000) == 0;
-	const u32 index0 = m_index[frame + 0] & 0x7FFFFFFF;
-	const u32 index1 = m_index[frame + 1] & 0x7FFFFFFF;
+	const u8* data = m_frames.Get(frame);
+	if (!data)
+		return 0;
 
-	// Calculate where the compressed payload is (if compressed.)
-	const u64 frameRawPos = (u64)index0 << m_indexShift;
-	const u64 frameRawSize = (u64)(index1 - index0) << m_indexShift;
+	// Now we just copy the offset data from the cache.
+	memcpy(dest, data + offset, bytes);
 
-	if (!compressed)
-	{
-		// Just read directly, easy.
-		if (PX_fseeko(m_src, m_dataoffset + frameRawPos + offset, SEEK_SET) != 0)
-		{
-			log_cb(RETRO_LOG_ERROR, "Unable to seek to uncompressed CSO data.\n");
-			return 0;
-		}
-		return fread(dest, 1, bytes, m_src);
-	}
-	else
+	return bytes;
+}
+
+bool CsoFileReader::DecompressFrame(Decoder* decoder, u32 frame, u8* dest)
+{
+	if (!IsFrameCompressed(frame))
 	{
-		// We don't need to decompress if we already did this same frame last time.
-		if (m_zlibBufferFrame != frame)
+		// Just read directly, easy. The last frame may be partial.
+		const u64 frameRawPos = (u64)(m_index[frame] & 0x7FFFFFFF) << m_indexShift;
+		const u32 frameBytes = (u32)std::min<u64>(m_frameSize, m_totalSize - ((u64)frame << m_frameShift));
+		if (PX_fseeko(decoder->src, m_dataoffset + frameRawPos, SEEK_SET) != 0 ||
+			fread(dest, 1, frameBytes, decoder->src) != frameBytes)
 		{
-			if (PX_fseeko(m_src, m_dataoffset + frameRawPos, SEEK_SET) != 0)
-			{
-				log_cb(RETRO_LOG_ERROR, "Unable to seek to compressed CSO data.\n");
-				return 0;
-			}
-			// This might be less bytes than frameRawSize in case of padding on the last frame.
-			// This is because the index positions must be aligned.
-			const u32 readRawBytes = fread(m_readBuffer, 1, frameRawSize, m_src);
-			if (!DecompressFrame(frame, readRawBytes))
-			{
-				return 0;
-			}
+			log_cb(RETRO_LOG_ERROR, "Unable to read uncompressed CSO data.\n");
+			return false;
 		}
-
-		// Now we just copy the offset data from the cache.
-		memcpy(dest, m_zlibBuffer + offset, bytes);
+		return true;
 	}
 
-	return bytes;
-}
+	// Calculate where the compressed payload is.
+	const u32 index0 = m_index[frame + 0] & 0x7FFFFFFF;
+	const u32 index1 = m_index[frame + 1] & 0x7FFFFFFF;
+	const u64 frameRawPos = (u64)index0 << m_indexShift;
+	const u64 frameRawSize = (u64)(index1 - index0) << m_indexShift;
 
-bool CsoFileReader::DecompressFrame(u32 frame, u32 readBufferSize)
-{
-	m_z_stream->next_in = m_readBuffer;
-	m_z_stream->avail_in = readBufferSize;
-	m_z_stream->next_out = m_zlibBuffer;
-	m_z_stream->avail_out = m_frameSize;
-
-	int status = inflate(m_z_stream, Z_FINISH);
-	bool success = status == Z_STREAM_END && m_z_stream->total_out == m_frameSize;
-	if (success)
+	if (PX_fseeko(decoder->src, m_dataoffset + frameRawPos, SEEK_SET) != 0)
 	{
-		// Our buffer now contains this frame.
-		m_zlibBufferFrame = frame;
+		log_cb(RETRO_LOG_ERROR, "Unable to seek to compressed CSO data.\n");
+		return false;
 	}
-	else
+	// This might be less bytes than frameRawSize in case of padding on the last frame.
+	// This is because the index positions must be aligned.
+	const u32 readRawBytes = fread(decoder->readBuffer, 1, frameRawSize, decoder->src);
+
+	z_stream* z = decoder->stream;
+	z->next_in = decoder->readBuffer;
+	z->avail_in = readRawBytes;
+	z->next_out = dest;
+	z->avail_out = m_frameSize;
+
+	int status = inflate(z, Z_FINISH);
+	bool success = status == Z_STREAM_END && z->total_out == m_frameSize;
+	if (!success)
 	{
 		log_cb(RETRO_LOG_ERROR, "Unable to decompress CSO frame using zlib.\n");
-		m_zlibBufferFrame = (u32)-1;
 	}
 
-	inflateReset(m_z_stream);
+	inflateReset(z);
 	return success;
 }
 
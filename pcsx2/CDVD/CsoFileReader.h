@@ -24,14 +24,24 @@
 // For this reason, it's currently disabled.
 #define CSO_USE_CHUNKSCACHE 0
 
+#include <vector>
+
 #include "AsyncFileReader.h"
 #include "ChunksCache.h"
+#include "DecodedBlockCache.h"
 
 struct CsoHeader;
 typedef struct z_stream_s z_stream;
 
 static const uint CSO_CHUNKCACHE_SIZE_MB = 200;
 
+// Frames are decoded into a DecodedBlockCache. A read queues all the frames it
+// spans at once, plus a few following frames for sequential streams (FMVs,
+// level streaming).
+static const uint CSO_FRAME_CACHE_SIZE = 32;   // decoded frames kept around
+static const uint CSO_PREFETCH_FRAMES = 4;     // frames decoded ahead of a read
+static const uint CSO_MAX_DECODER_THREADS = 4;
+
 class CsoFileReader : public AsyncFileReader
 {
 	DeclareNoncopyableObject(CsoFileReader);
@@ -41,13 +51,9 @@ public:
 		: m_frameSize(0)
 		, m_frameShift(0)
 		, m_indexShift(0)
-		, m_readBuffer(0)
-		, m_zlibBuffer(0)
-		, m_zlibBufferFrame(0)
 		, m_index(0)
 		, m_totalSize(0)
 		, m_src(0)
-		, m_z_stream(0)
 		,
 #if CSO_USE_CHUNKSCACHE
 		m_cache(CSO_CHUNKCACHE_SIZE_MB)
@@ -84,19 +90,39 @@ private:
 	bool ReadFileHeader();
 	bool InitializeBuffers();
 	int ReadFromFrame(u8* dest, u64 pos, int maxBytes);
-	bool DecompressFrame(u32 frame, u32 readBufferSize);
+
+	struct Decoder
+	{
+		Decoder()
+			: stream(0)
+			, src(0)
+			, readBuffer(0)
+		{
+		}
+
+		z_stream* stream;
+		FILE* src;
+		u8* readBuffer;
+	};
+
+	bool IsFrameCompressed(u32 frame) const { return (m_index[frame] & 0x80000000) == 0; }
+	bool InitDecoder(Decoder* decoder);
+	void FreeDecoder(Decoder* decoder);
+	bool StartDecoders();
+	void StopDecoders();
+	bool DecompressFrame(Decoder* decoder, u32 frame, u8* dest);
 
 	u32 m_frameSize;
 	u8 m_frameShift;
 	u8 m_indexShift;
-	u8* m_readBuffer;
-	u8* m_zlibBuffer;
-	u32 m_zlibBufferFrame;
 	u32* m_index;
 	u64 m_totalSize;
 	// The actual source cso file handle.
 	FILE* m_src;
-	z_stream* m_z_stream;
+
+	// Decoded frames, and a decoder for the reader and each of the cache workers
+	DecodedBlockCache m_frames;
+	std::vector<Decoder> m_decoders;
 
 #if CSO_USE_CHUNKSCACHE
 	ChunksCache m_cache;
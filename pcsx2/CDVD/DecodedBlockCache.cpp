@@ -0,0 +1,219 @@
+/*  PCSX2 - PS2 Emulator for PCs
+*  Copyright (C) 2002-2021  PCSX2 Dev Team
+*
+*  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+*  of the GNU Lesser General Public License as published by the Free Software Found-
+*  ation, either version 3 of the License, or (at your option) any later version.
+*
+*  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+*  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+*  PURPOSE.  See the GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License along with PCSX2.
+*  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PrecompiledHeader.h"
+#include "DecodedBlockCache.h"
+
+#include <algorithm>
+#include <chrono>
+
+DecodedBlockCache::DecodedBlockCache(void)
+	: m_blockCount(0)
+	, m_data(0)
+	, m_useTick(0)
+	, m_exit(false)
+	, m_hits(0)
+	, m_prefetchHits(0)
+	, m_misses(0)
+	, m_decodeUs(0)
+{
+}
+
+uint DecodedBlockCache::GetDefaultThreadCount(uint maxThreads)
+{
+	// Without spare cores, handing blocks over to other threads only adds latency
+	return std::min(std::thread::hardware_concurrency() / 2, maxThreads);
+}
+
+void DecodedBlockCache::Open(uint slots, uint blockSize, u32 blockCount, uint threads, const DecodeFn& decode)
+{
+	Close();
+
+	m_decode = decode;
+	m_blockCount = blockCount;
+
+	m_data = new u8[(size_t)slots * blockSize];
+	m_slots.resize(slots);
+	for (uint i = 0; i < slots; i++)
+	{
+		m_slots[i].state = Slot::Empty;
+		m_slots[i].prefetched = false;
+		m_slots[i].block = blockCount;
+		m_slots[i].lastUse = 0;
+		m_slots[i].data = m_data + (size_t)i * blockSize;
+	}
+	m_useTick = 0;
+	m_hits = m_prefetchHits = m_misses = m_decodeUs = 0;
+
+	m_exit = false;
+	for (uint i = 1; i <= threads; i++)
+		m_threads.push_back(std::thread(&DecodedBlockCache::WorkerThread, this, i));
+}
+
+void DecodedBlockCache::Close(void)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_lock);
+		m_exit = true;
+		m_queue.clear();
+	}
+	m_queueCond.notify_all();
+
+	for (std::thread& thread : m_threads)
+		thread.join();
+	m_threads.clear();
+
+	m_slots.clear();
+	if (m_data)
+	{
+		delete[] m_data;
+		m_data = NULL;
+	}
+}
+
+void DecodedBlockCache::LogStats(const char* name)
+{
+	std::lock_guard<std::mutex> lock(m_lock);
+	if (!m_hits && !m_misses)
+		return;
+
+	log_cb(RETRO_LOG_INFO, "%s cache: %llu hits (%llu decoded ahead), %llu misses, %llu ms decoding\n", name,
+		(unsigned long long)m_hits, (unsigned long long)m_prefetchHits,
+		(unsigned long long)m_misses, (unsigned long long)(m_decodeUs / 1000));
+}
+
+// Must be called with m_lock held. Returns the slot holding (or about to hold)
+// the block, claiming the least recently used slot for it if needed, or NULL
+// when every slot is pending. Claimed slots are pending and either queued for
+// the workers or, when !queue, left for the caller to decode.
+DecodedBlockCache::Slot* DecodedBlockCache::Request(u32 block, bool queue, bool* claimed)
+{
+	Slot* victim = NULL;
+	if (claimed)
+		*claimed = false;
+
+	for (Slot& slot : m_slots)
+	{
+		if (slot.state != Slot::Empty && slot.block == block)
+		{
+			slot.lastUse = ++m_useTick;
+			return &slot;
+		}
+
+		if (slot.state == Slot::Pending)
+			continue;
+
+		if (!victim || slot.lastUse < victim->lastUse)
+			victim = &slot;
+	}
+
+	if (!victim)
+		return NULL;
+
+	victim->state = Slot::Pending;
+	victim->prefetched = false;
+	victim->block = block;
+	victim->lastUse = ++m_useTick;
+	if (claimed)
+		*claimed = true;
+	if (queue)
+	{
+		m_queue.push_back(victim);
+		m_queueCond.notify_one();
+	}
+	return victim;
+}
+
+// Decodes a pending slot with m_lock released, pending slots are neither
+// evicted nor touched by anyone else.
+bool DecodedBlockCache::Decode(uint decoder, Slot* slot, std::unique_lock<std::mutex>& lock)
+{
+	const u32 block = slot->block;
+
+	lock.unlock();
+	auto start = std::chrono::steady_clock::now();
+	bool success = m_decode(decoder, block, slot->data);
+	auto duration = std::chrono::steady_clock::now() - start;
+	lock.lock();
+
+	m_decodeUs += std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+	slot->state = success ? Slot::Ready : Slot::Failed;
+	m_readyCond.notify_all();
+	return success;
+}
+
+void DecodedBlockCache::WorkerThread(uint decoder)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	while (true)
+	{
+		m_queueCond.wait(lock, [this] { return m_exit || !m_queue.empty(); });
+		if (m_exit)
+			return;
+
+		Slot* slot = m_queue.front();
+		m_queue.pop_front();
+
+		slot->prefetched = Decode(decoder, slot, lock);
+	}
+}
+
+void DecodedBlockCache::Prefetch(u32 first, u32 last)
+{
+	if (m_threads.empty() || first >= m_blockCount)
+		return;
+
+	last = std::min(std::min(last, m_blockCount - 1), first + (u32)m_slots.size() / 2 - 1);
+
+	std::lock_guard<std::mutex> lock(m_lock);
+	for (u32 block = first; block <= last; block++)
+		Request(block, true, NULL);
+}
+
+const u8* DecodedBlockCache::Get(u32 block)
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	Slot* slot;
+	bool claimed;
+	while (!(slot = Request(block, false, &claimed)))
+		m_readyCond.wait(lock);
+
+	if (claimed)
+	{
+		m_misses++;
+		Decode(0, slot, lock);
+	}
+	else
+	{
+		m_readyCond.wait(lock, [slot] { return slot->state != Slot::Pending; });
+
+		m_hits++;
+		if (slot->prefetched)
+			m_prefetchHits++;
+	}
+	slot->prefetched = false;
+
+	if (slot->state == Slot::Failed)
+	{
+		// Try again next time
+		slot->state = Slot::Empty;
+		slot->lastUse = 0;
+		return NULL;
+	}
+
+	return slot->data;
+}
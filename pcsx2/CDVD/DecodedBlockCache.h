@@ -0,0 +1,98 @@
+/*  PCSX2 - PS2 Emulator for PCs
+*  Copyright (C) 2002-2021  PCSX2 Dev Team
+*
+*  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+*  of the GNU Lesser General Public License as published by the Free Software Found-
+*  ation, either version 3 of the License, or (at your option) any later version.
+*
+*  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+*  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+*  PURPOSE.  See the GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License along with PCSX2.
+*  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// LRU of decoded blocks (CSO frames, CHD hunks, XZ blocks) shared by all the
+// reads of a compressed image. The blocks following a read are decoded ahead by
+// a pool of worker threads, anything else is decoded by the reader right away
+// rather than going through the workers.
+class DecodedBlockCache
+{
+	DeclareNoncopyableObject(DecodedBlockCache);
+
+public:
+	// Decodes a block into dest (block size bytes). Decoder 0 is the reader and
+	// 1 to threads are the workers, so each of them can have its own handles.
+	typedef std::function<bool(uint decoder, u32 block, u8* dest)> DecodeFn;
+
+	DecodedBlockCache(void);
+	~DecodedBlockCache(void) { Close(); }
+
+	// Worker threads worth starting, at most maxThreads
+	static uint GetDefaultThreadCount(uint maxThreads);
+
+	void Open(uint slots, uint blockSize, u32 blockCount, uint threads, const DecodeFn& decode);
+	// Stops the workers, must be done before freeing their decoders
+	void Close(void);
+
+	// Queues blocks first to last for the workers, but never enough of them to
+	// evict the first blocks of the same read.
+	void Prefetch(u32 first, u32 last);
+	// Returns the decoded block, valid until the next Get() or Prefetch(), or
+	// NULL on error.
+	const u8* Get(u32 block);
+
+	void LogStats(const char* name);
+
+private:
+	struct Slot
+	{
+		enum State
+		{
+			Empty,
+			Pending, // queued or being decoded, can't be evicted
+			Ready,
+			Failed,
+		};
+
+		State state;
+		bool prefetched; // decoded ahead, and not read yet
+		u32 block;
+		u64 lastUse;
+		u8* data;
+	};
+
+	Slot* Request(u32 block, bool queue, bool* claimed);
+	bool Decode(uint decoder, Slot* slot, std::unique_lock<std::mutex>& lock);
+	void WorkerThread(uint decoder);
+
+	DecodeFn m_decode;
+	u32 m_blockCount;
+
+	// Everything below is protected by m_lock
+	std::vector<Slot> m_slots;
+	u8* m_data;
+	u64 m_useTick;
+	std::vector<std::thread> m_threads;
+	std::deque<Slot*> m_queue;
+	std::mutex m_lock;
+	std::condition_variable m_queueCond; // work queued, or exit
+	std::condition_variable m_readyCond; // a block is not pending anymore
+	bool m_exit;
+
+	// Statistics, to size the cache
+	u64 m_hits;
+	u64 m_prefetchHits; // hits on blocks which were decoded ahead
+	u64 m_misses;
+	u64 m_decodeUs;
+};
@@ -24,6 +24,9 @@
 
 #define CLAMP(val, minval, maxval) (std::min(maxval, std::max(minval, val)))
 
+#define PTT clock_t
+#define NOW() (clock() / (CLOCKS_PER_SEC / 1000))
+
 static s64 fsize(const wxString& filename)
 {
 	if (!wxFileName::FileExists(filename))
@@ -37,14 +40,36 @@ static s64 fsize(const wxString& filename)
 	return size;
 }
 
-#define GZIP_ID "PCSX2.index.gzip.v1|"
+#define GZIP_ID "PCSX2.index.gzip.v2|"
 #define GZIP_ID_LEN (sizeof(GZIP_ID) - 1) /* sizeof includes the \0 terminator */
 
+// Identifies the compressed image an index was built from
+struct GzIndexStamp
+{
+	s64 size;
+	s64 mtime;
+};
+
+static GzIndexStamp GetIndexStamp(const wxString& isoname)
+{
+	GzIndexStamp stamp = {-1, 0};
+	wxStructStat st;
+
+	if (wxStat(isoname, &st) == 0)
+	{
+		stamp.size = st.st_size;
+		stamp.mtime = st.st_mtime;
+	}
+	return stamp;
+}
+
 // File format is:
 // - [GZIP_ID_LEN] GZIP_ID (no \0)
+// - [sizeof(GzIndexStamp)] size and modification time of the compressed image
 // - [sizeof(Access)] index (should be allocated, contains various sizes)
 // - [rest] the indexed data points (should be allocated, index->list should then point to it)
-static Access* ReadIndexFromFile(const wxString& filename)
+// Indexes with another id or stamp are stale and get rebuilt (and overwritten).
+static Access* ReadIndexFromFile(const wxString& filename, const GzIndexStamp& expected)
 {
 	s64 size = fsize(filename);
 	if (size <= 0)
@@ -58,7 +83,16 @@ static Access* ReadIndexFromFile(const wxString& filename)
 	infile.read(fileId, GZIP_ID_LEN);
 	if (wxString::From8BitData(GZIP_ID) != wxString::From8BitData(fileId))
 	{
-		log_cb(RETRO_LOG_ERROR, "Error: Incompatible gzip index, please delete it manually: '%s'\n", WX_STR(filename));
+		log_cb(RETRO_LOG_WARN, "Gzip index has an old or unknown format and will be rebuilt: '%s'\n", WX_STR(filename));
+		infile.close();
+		return 0;
+	}
+
+	GzIndexStamp stamp = {0};
+	infile.read((char*)&stamp, sizeof(stamp));
+	if (stamp.size != expected.size || stamp.mtime != expected.mtime)
+	{
+		log_cb(RETRO_LOG_WARN, "Gzip index does not match the image anymore and will be rebuilt: '%s'\n", WX_STR(filename));
 		infile.close();
 		return 0;
 	}
@@ -66,10 +100,10 @@ static Access* ReadIndexFromFile(const wxString& filename)
 	Access* index = (Access*)malloc(sizeof(Access));
 	infile.read((char*)index, sizeof(Access));
 
-	s64 datasize = size - GZIP_ID_LEN - sizeof(Access);
-	if (datasize != (s64)index->have * sizeof(Point))
+	s64 datasize = size - GZIP_ID_LEN - sizeof(GzIndexStamp) - sizeof(Access);
+	if (!infile || index->have <= 0 || datasize != (s64)(index->have * sizeof(Point)))
 	{
-		log_cb(RETRO_LOG_ERROR, "Error: unexpected size of gzip index, please delete it manually: '%s'.\n", WX_STR(filename));
+		log_cb(RETRO_LOG_WARN, "Gzip index has an unexpected size and will be rebuilt: '%s'.\n", WX_STR(filename));
 		infile.close();
 		free(index);
 		return 0;
@@ -82,29 +116,30 @@ static Access* ReadIndexFromFile(const wxString& filename)
 	return index;
 }
 
-static void WriteIndexToFile(Access* index, const wxString filename)
+static void WriteIndexToFile(const Access* index, const wxString filename, const GzIndexStamp& stamp)
 {
-	if (wxFileName::FileExists(filename))
-	{
-		log_cb(RETRO_LOG_WARN, "WARNING: Won't write index - file name exists (please delete it manually): '%s'\n", WX_STR(filename));
-		return;
-	}
+	// Written under a temporary name and renamed, so that an interrupted write
+	// never leaves a truncated index behind (a stale one is simply replaced).
+	wxString tmpname = filename + L".tmp";
 
-	std::ofstream outfile(PX_wfilename(filename), std::ofstream::binary);
+	std::ofstream outfile(PX_wfilename(tmpname), std::ofstream::binary);
 	outfile.write(GZIP_ID, GZIP_ID_LEN);
+	outfile.write((const char*)&stamp, sizeof(stamp));
 
-	Point* tmp = index->list;
-	index->list = 0; // current pointer is useless on disk, normalize it as 0.
-	outfile.write((char*)index, sizeof(Access));
-	index->list = tmp;
+	// Readers may use the index meanwhile, so normalize the pointer (useless on disk) in a copy
+	Access header = *index;
+	header.list = 0;
+	outfile.write((const char*)&header, sizeof(Access));
 
-	outfile.write((char*)index->list, sizeof(Point) * index->have);
+	outfile.write((const char*)index->list, sizeof(Point) * index->have);
 	outfile.close();
 
 	// Verify
-	if (fsize(filename) != (s64)GZIP_ID_LEN + sizeof(Access) + sizeof(Point) * index->have)
+	if (fsize(tmpname) != (s64)(GZIP_ID_LEN + sizeof(GzIndexStamp) + sizeof(Access) + sizeof(Point) * index->have) ||
+		!wxRenameFile(tmpname, filename, true))
 	{
 		log_cb(RETRO_LOG_WARN, "Warning: Can't write index file to disk: '%s'\n", WX_STR(filename));
+		wxRemoveFile(tmpname);
 	}
 	else
 	{
@@ -163,11 +198,87 @@ static wxString iso2indexname(const wxString& isoname)
 	return ApplyTemplate(L"gzip index", appRoot, g_Conf->GzipIsoIndexTemplate, isoname, false);
 }
 
+// The uncompressed size is only known for sure once the whole stream was
+// inflated. Until then it's derived from the gzip trailer (size modulo 4 GB),
+// disambiguated with a lower bound from the compressed size and the volume
+// size of the ISO9660 primary volume descriptor at the start of the image.
+static PX_off_t EstimateUncompressedSize(FILE* in, s64 compressedSize)
+{
+	static const int PVD_SECTOR = 16;
+	static const struct
+	{
+		int offset;
+		int sectorSize;
+	} pvds[] = {
+		{PVD_SECTOR * 2048, 2048},      // plain iso
+		{PVD_SECTOR * 2352 + 24, 2352}, // raw mode 2
+		{PVD_SECTOR * 2352 + 16, 2352}, // raw mode 1
+	};
+	const int headSize = PVD_SECTOR * 2352 + 24 + 2048;
+
+	unsigned char trailer[4];
+	if (PX_fseeko(in, -4, SEEK_END) || fread(trailer, 1, 4, in) != 4)
+		return 0;
+	PX_off_t isize = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((u32)trailer[3] << 24);
+
+	// Deflate never expands by more than a few bytes per 16 KB block
+	PX_off_t lowerBound = compressedSize - compressedSize / 256 - 1024;
+
+	unsigned char* head = (unsigned char*)malloc(headSize);
+	unsigned char* input = (unsigned char*)malloc(CHUNK);
+	z_stream strm = {0};
+	if (head && input && inflateInit2(&strm, 47) == Z_OK)
+	{
+		PX_fseeko(in, 0, SEEK_SET);
+		strm.next_out = head;
+		strm.avail_out = headSize;
+
+		int ret = Z_OK;
+		while (ret == Z_OK && strm.avail_out)
+		{
+			strm.avail_in = fread(input, 1, CHUNK, in);
+			strm.next_in = input;
+			if (!strm.avail_in)
+				break;
+			ret = inflate(&strm, Z_NO_FLUSH);
+		}
+		inflateEnd(&strm);
+
+		int have = headSize - strm.avail_out;
+		for (const auto& pvd : pvds)
+		{
+			const unsigned char* p = head + pvd.offset;
+			if (pvd.offset + 88 > have || p[0] != 1 || memcmp(p + 1, "CD001", 5))
+				continue;
+
+			// Images are sometimes trimmed a little, allow some slack
+			PX_off_t volumeSize = (PX_off_t)(p[80] | (p[81] << 8) | (p[82] << 16) | ((u32)p[83] << 24)) * pvd.sectorSize;
+			lowerBound = std::max(lowerBound, volumeSize - 64 * 1024 * 1024);
+			break;
+		}
+	}
+	free(input);
+	free(head);
+	PX_fseeko(in, 0, SEEK_SET);
+
+	PX_off_t size = isize;
+	while (size < lowerBound)
+		size += (PX_off_t)1 << 32;
+
+	return size;
+}
+
 GzippedFileReader::GzippedFileReader(void)
 	: mBytesRead(0)
 	, m_pIndex(0)
 	, m_zstates(0)
+	, m_zstatesCount(0)
 	, m_src(0)
+	, m_span(GZFILE_SPAN_DEFAULT)
+	, m_uncompressedSize(0)
+	, m_sizeExact(false)
+	, m_indexAbort(false)
+	, m_indexBuilding(false)
 	, m_cache(GZFILE_CACHE_SIZE_MB)
 {
 	m_blocksize = 2048;
@@ -180,13 +291,14 @@ void GzippedFileReader::InitZstates()
 	{
 		delete[] m_zstates;
 		m_zstates = 0;
+		m_zstatesCount = 0;
 	}
-	if (!m_pIndex)
+	if (!m_pIndex && !m_indexBuilding)
 		return;
 
 	// having another extra element helps avoiding logic for last (so 2+ instead of 1+)
-	int size = 2 + m_pIndex->uncompressed_size / m_pIndex->span;
-	m_zstates = new Czstate[size]();
+	m_zstatesCount = 2 + m_uncompressedSize / m_span;
+	m_zstates = new Czstate[m_zstatesCount]();
 }
 
 #ifndef _WIN32
@@ -278,17 +390,17 @@ bool GzippedFileReader::CanHandle(const wxString& fileName)
 
 bool GzippedFileReader::OkIndex()
 {
-	if (m_pIndex)
+	if (m_indexThread.joinable() || m_pIndex)
 		return true;
 
 	// Try to read index from disk
-	wxString indexfile = iso2indexname(m_filename);
-	if (indexfile.length() == 0)
+	m_indexFile = iso2indexname(m_filename);
+	if (m_indexFile.length() == 0)
 		return false; // iso2indexname(...) will print errors if it can't apply the template
 
-	if (wxFileName::FileExists(indexfile) && (m_pIndex = ReadIndexFromFile(indexfile)))
+	if (wxFileName::FileExists(m_indexFile) && (m_pIndex = ReadIndexFromFile(m_indexFile, GetIndexStamp(m_filename))))
 	{
-		log_cb(RETRO_LOG_INFO, "OK: Gzip quick access index read from disk: '%s'\n", WX_STR(indexfile));
+		log_cb(RETRO_LOG_INFO, "OK: Gzip quick access index read from disk: '%s'\n", WX_STR(m_indexFile));
 #ifndef NDEBUG
 		if (m_pIndex->span != GZFILE_SPAN_DEFAULT)
 		{
@@ -298,34 +410,85 @@ bool GzippedFileReader::OkIndex()
 			log_cb(RETRO_LOG_WARN, "(smaller intervals mean bigger index file and quicker but more frequent decompressions)\n");
 		}
 #endif
+		m_span = m_pIndex->span;
+		m_uncompressedSize = m_pIndex->uncompressed_size;
+		m_sizeExact = true;
 		InitZstates();
 		return true;
 	}
 
-	// No valid index file. Generate an index
-	log_cb(RETRO_LOG_WARN, "This may take a while (but only once). Scanning compressed file to generate a quick access index...\n");
+	// No valid index file. Generate one in the background, reads inflate from
+	// the closest access point found so far in the meantime.
+	m_span = GZFILE_SPAN_DEFAULT;
+	m_uncompressedSize = EstimateUncompressedSize(m_src, fsize(m_filename));
+	m_sizeExact = false;
+	log_cb(RETRO_LOG_INFO, "Scanning compressed file in the background to generate a quick access index...\n");
+
+	StartIndexBuild();
+	InitZstates();
+	return true;
+}
+
+void GzippedFileReader::LockIndex(void* opaque)
+{
+	static_cast<GzippedFileReader*>(opaque)->m_indexLock.lock();
+}
 
-	Access* index;
+void GzippedFileReader::UnlockIndex(void* opaque)
+{
+	GzippedFileReader* reader = static_cast<GzippedFileReader*>(opaque);
+	reader->m_indexLock.unlock();
+	reader->m_indexCond.notify_all();
+}
+
+int GzippedFileReader::IsIndexBuildAborted(void* opaque)
+{
+	return static_cast<GzippedFileReader*>(opaque)->m_indexAbort.load(std::memory_order_relaxed);
+}
+
+void GzippedFileReader::StartIndexBuild()
+{
+	m_indexAbort = false;
+	m_indexBuilding = true;
+	m_indexThread = std::thread(&GzippedFileReader::IndexBuildThread, this);
+}
+
+void GzippedFileReader::StopIndexBuild()
+{
+	if (!m_indexThread.joinable())
+		return;
+
+	m_indexAbort = true;
+	m_indexThread.join();
+}
+
+void GzippedFileReader::IndexBuildThread()
+{
+	const Index_hooks hooks = {this, LockIndex, UnlockIndex, IsIndexBuildAborted};
+	const GzIndexStamp stamp = GetIndexStamp(m_filename);
+
+	PTT s = NOW();
 	FILE* infile = PX_fopen_rb(m_filename);
-	int len = build_index(infile, GZFILE_SPAN_DEFAULT, &index);
+	int len = infile ? build_index_async(infile, m_span, &m_pIndex, &hooks) : Z_ERRNO;
 	printf("\n"); // build_index prints progress without \n's
-	fclose(infile);
+	if (infile)
+		fclose(infile);
 
-	if (len >= 0)
+	// The index is complete and only read from now on (by the reader as well),
+	// the reader picks up the exact size once m_indexBuilding is cleared.
+	if (len > 0)
 	{
-		m_pIndex = index;
-		WriteIndexToFile((Access*)m_pIndex, indexfile);
+		log_cb(RETRO_LOG_INFO, "OK: Gzip quick access index generated in %d ms\n", (int)(NOW() - s));
+		WriteIndexToFile(m_pIndex, m_indexFile, stamp);
 	}
-	else
+	else if (len != Z_INDEX_ABORTED)
 	{
 		log_cb(RETRO_LOG_ERROR, "ERROR (%d): index could not be generated for file '%s'\n", len, WX_STR(m_filename));
-		free_index(index);
-		InitZstates();
-		return false;
 	}
 
-	InitZstates();
-	return true;
+	std::lock_guard<std::mutex> lock(m_indexLock);
+	m_indexBuilding = false;
+	m_indexCond.notify_all();
 }
 
 bool GzippedFileReader::Open(const wxString& fileName)
@@ -356,9 +519,6 @@ int GzippedFileReader::FinishRead(void)
 	return res;
 };
 
-#define PTT clock_t
-#define NOW() (clock() / (CLOCKS_PER_SEC / 1000))
-
 int GzippedFileReader::ReadSync(void* pBuffer, uint sector, uint count)
 {
 	PX_off_t offset = (s64)sector * m_blocksize + m_dataoffset;
@@ -371,12 +531,29 @@ int GzippedFileReader::ReadSync(void* pBuffer, uint sector, uint count)
 	return res;
 }
 
+// Replaces the estimated size with the one found by the index build once it's done
+void GzippedFileReader::AdoptIndexSize()
+{
+	std::lock_guard<std::mutex> lock(m_indexLock);
+	if (m_indexBuilding)
+		return;
+
+	m_sizeExact = true;
+	if (!m_pIndex || m_pIndex->uncompressed_size == m_uncompressedSize)
+		return;
+
+	log_cb(RETRO_LOG_INFO, "Gzip image size corrected from the estimated %lld bytes to %lld.\n",
+			(long long)m_uncompressedSize, (long long)m_pIndex->uncompressed_size);
+	m_uncompressedSize = m_pIndex->uncompressed_size;
+	InitZstates(); // sized after m_uncompressedSize
+}
+
 // If we have a valid and adequate zstate for this span, use it, else, use the index
 PX_off_t GzippedFileReader::GetOptimalExtractionStart(PX_off_t offset)
 {
-	int span = m_pIndex->span;
-	Czstate& cstate = m_zstates[offset / span];
-	PX_off_t stateOffset = cstate.state.isValid ? cstate.state.out_offset : 0;
+	int span = m_span;
+	int ix = offset / span;
+	PX_off_t stateOffset = (ix < m_zstatesCount && m_zstates[ix].state.isValid) ? m_zstates[ix].state.out_offset : 0;
 	if (stateOffset && stateOffset <= offset)
 		return stateOffset; // state is faster than indexed
 
@@ -393,6 +570,9 @@ int GzippedFileReader::_ReadSync(void* pBuffer, PX_off_t offset, uint bytesToRea
 	if (!OkIndex())
 		return -1;
 
+	if (!m_sizeExact)
+		AdoptIndexSize();
+
 	// Without all the caching, chunking and states, this would be enough:
 	// return extract(m_src, m_pIndex, offset, (unsigned char*)pBuffer, bytesToRead);
 
@@ -417,17 +597,53 @@ int GzippedFileReader::_ReadSync(void* pBuffer, PX_off_t offset, uint bytesToRea
 	if (res >= 0)
 		return res;
 
+	if (offset >= m_uncompressedSize)
+		return 0;
+
 	// Not available from cache. Decompress from optimal starting
 	// point in GZFILE_READ_CHUNK_SIZE chunks and cache each chunk.
 	PTT s = NOW();
 	PX_off_t extractOffset = GetOptimalExtractionStart(offset); // guaranteed in GZFILE_READ_CHUNK_SIZE boundaries
 	int size = offset + maxInChunk - extractOffset;
-	unsigned char* extracted = (unsigned char*)malloc(size);
 
-	int span = m_pIndex->span;
+	int span = m_span;
 	int spanix = extractOffset / span;
+
+	// While the index is being built its list may be reallocated at any time,
+	// so only the access point lookup is done under the lock, and extraction
+	// starts from a private copy of that point (only a zstate which is valid at
+	// extractOffset needs none, extract() discards any other).
+	Access* index = m_pIndex;
+	Access view;
+	Point point;
+	if (!m_sizeExact)
+	{
+		std::unique_lock<std::mutex> lock(m_indexLock);
+		m_indexCond.wait(lock, [this] { return m_pIndex || !m_indexBuilding; });
+		if (!m_pIndex)
+			return -1;
+
+		const Zstate& state = m_zstates[spanix].state;
+		if (!state.isValid || state.out_offset != extractOffset)
+		{
+			const Point* here = m_pIndex->list;
+			int left = m_pIndex->have;
+			while (--left && here[1].out <= extractOffset)
+				here++;
+			point = *here;
+		}
+		view = *m_pIndex;
+		view.have = 1;
+		view.list = &point;
+		index = &view;
+	}
+	if (!index)
+		return -1;
+
+	unsigned char* extracted = (unsigned char*)malloc(size);
+
 	AsyncPrefetchCancel();
-	res = extract(m_src, m_pIndex, extractOffset, extracted, size, &(m_zstates[spanix].state));
+	res = extract(m_src, index, extractOffset, extracted, size, &(m_zstates[spanix].state));
 	if (res < 0)
 	{
 		free(extracted);
@@ -482,6 +698,8 @@ int GzippedFileReader::_ReadSync(void* pBuffer, PX_off_t offset, uint bytesToRea
 
 void GzippedFileReader::Close()
 {
+	StopIndexBuild();
+
 	m_filename.Empty();
 	if (m_pIndex)
 	{
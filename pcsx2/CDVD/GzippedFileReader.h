@@ -17,6 +17,11 @@
 
 typedef struct zstate Zstate;
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #include "AsyncFileReader.h"
 #include "ChunksCache.h"
 #include "zlib_indexed.h"
@@ -49,7 +54,7 @@ public:
 	{
 		// type and formula copied from FlatFileReader
 		// FIXME? : Shouldn't it be uint and (size - m_dataoffset) / m_blocksize ?
-		return (int)((m_pIndex ? m_pIndex->uncompressed_size : 0) / m_blocksize);
+		return (int)(m_uncompressedSize / m_blocksize);
 	};
 
 	virtual void SetBlockSize(uint bytes) { m_blocksize = bytes; }
@@ -74,12 +79,36 @@ private:
 	PX_off_t GetOptimalExtractionStart(PX_off_t offset);
 	int _ReadSync(void* pBuffer, PX_off_t offset, uint bytesToRead);
 	void InitZstates();
+	void AdoptIndexSize();
+
+	// The index is built by a background thread when there's no valid index file.
+	// Until it's done, m_pIndex holds the access points found so far and is
+	// protected by m_indexLock, and reads inflate from a copy of the last point
+	// before them. The exact size replaces the estimated one when it completes.
+	void StartIndexBuild();
+	void StopIndexBuild();
+	void IndexBuildThread();
+	static void LockIndex(void* opaque);
+	static void UnlockIndex(void* opaque);
+	static int IsIndexBuildAborted(void* opaque);
 
 	int mBytesRead;   // Temp sync read result when simulating async read
 	Access* m_pIndex; // Quick access index
 	Czstate* m_zstates;
+	int m_zstatesCount;
 	FILE* m_src;
 
+	s32 m_span;                  // index span, known before the index is complete
+	PX_off_t m_uncompressedSize; // exact with an index file, estimated while building one
+	bool m_sizeExact;            // m_uncompressedSize and m_pIndex are final (reader side)
+	wxString m_indexFile;
+
+	std::thread m_indexThread;
+	std::mutex m_indexLock;
+	std::condition_variable m_indexCond;
+	std::atomic<bool> m_indexAbort;
+	bool m_indexBuilding;
+
 	ChunksCache m_cache;
 
 #ifdef _WIN32
@@ -41,6 +41,10 @@ static const char* nameFromType(int type)
 
 int InputIsoFile::ReadSync(u8* dst, uint lsn)
 {
+	// Some readers only know the exact size after a while (gzip index build)
+	if (lsn >= m_blocks)
+		m_blocks = m_reader->GetBlockCount();
+
 	if (lsn >= m_blocks)
 	{
 		FastFormatUnicode msg;
@@ -58,6 +62,9 @@ void InputIsoFile::BeginRead2(uint lsn)
 {
 	m_current_lsn = lsn;
 
+	if (lsn >= m_blocks)
+		m_blocks = m_reader->GetBlockCount();
+
 	if (lsn >= m_blocks)
 	{
 		// While this usually indicates that the ISO is corrupted, some games do attempt
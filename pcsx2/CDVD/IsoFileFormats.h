@@ -19,6 +19,7 @@
 #include "wx/wfstream.h"
 #include "AsyncFileReader.h"
 #include "CompressedFileReader.h"
+#include <atomic>
 #include <memory>
 
 enum isoType
@@ -74,6 +75,7 @@ public:
 	isoType GetType() const { return m_type; }
 	uint GetBlockCount() const { return m_blocks; }
 	int GetBlockOffset() const { return m_blockofs; }
+	uint GetBlockSize() const { return m_blocksize; }
 
 	const wxString& GetFilename() const
 	{
@@ -101,7 +103,15 @@ class OutputIsoFile
 {
 	DeclareNoncopyableObject(OutputIsoFile);
 
+public:
+	// Create() versions: 2 writes a blockdump, XzVersion a seekable .xz compressed
+	// image (see XzFileReader, sectors must then be written in increasing order),
+	// and anything else a plain image.
+	static const int XzVersion = 3;
+
 protected:
+	struct XzEncoder;
+
 	wxString m_filename;
 
 	u32 m_version;
@@ -117,6 +127,7 @@ protected:
 	std::vector<u32> m_dtable;
 
 	std::unique_ptr<wxFileOutputStream> m_outstream;
+	std::unique_ptr<XzEncoder> m_xz;
 
 public:
 	OutputIsoFile();
@@ -137,10 +148,15 @@ public:
 
 	void WriteSector(const u8* src, uint lsn);
 
+	// Writes the header and every sector of an opened image. Returns false when
+	// cancelled (*cancel set by another thread) before the end.
+	bool WriteImage(InputIsoFile& src, const std::atomic<bool>* cancel = NULL);
+
 protected:
 	void _init();
 
 	void WriteBuffer(const void* src, size_t size);
+	void WriteCompressed(const void* src, size_t size, bool finish = false);
 
 	template <typename T>
 	void WriteValue(const T& data)
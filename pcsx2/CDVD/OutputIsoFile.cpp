@@ -17,8 +17,17 @@
 #include "PrecompiledHeader.h"
 #include "IopCommon.h"
 #include "IsoFileFormats.h"
+#include "XzFileReader.h"
 
 #include <errno.h>
+#include <lzma.h>
+
+struct OutputIsoFile::XzEncoder
+{
+	lzma_stream strm;
+	u64 written; // uncompressed bytes so far
+	u8 out[64 * 1024];
+};
 
 void pxStream_OpenCheck(const wxStreamBase& stream, const wxString& fname, const wxString& mode)
 {
@@ -63,6 +72,25 @@ void OutputIsoFile::Create(const wxString& filename, int version)
 	m_outstream = std::make_unique<wxFileOutputStream>(m_filename);
 	pxStream_OpenCheck(*m_outstream, m_filename, L"writing");
 
+	if (m_version == XzVersion)
+	{
+		// Independent blocks, which the multi-threaded encoder also compresses in parallel
+		lzma_mt mt = {};
+		mt.threads = std::max(1u, lzma_cputhreads());
+		mt.block_size = XZ_OUTPUT_BLOCK_SIZE;
+		mt.preset = LZMA_PRESET_DEFAULT;
+		mt.check = LZMA_CHECK_CRC32;
+
+		m_xz = std::make_unique<XzEncoder>();
+		m_xz->strm = LZMA_STREAM_INIT;
+		m_xz->written = 0;
+		if (lzma_stream_encoder_mt(&m_xz->strm, &mt) != LZMA_OK)
+		{
+			m_xz.reset();
+			throw Exception::BadStream(m_filename).SetDiagMsg(L"Unable to initialize the xz encoder");
+		}
+	}
+
 	log_cb(RETRO_LOG_INFO, "isoFile create ok: %s \n", WX_STR(m_filename));
 }
 
@@ -98,6 +126,21 @@ void OutputIsoFile::WriteSector(const u8* src, uint lsn)
 
 		WriteValue<u32>(lsn);
 	}
+	else if (m_version == XzVersion)
+	{
+		static const u8 zeros[2352] = {};
+		u64 ofs = (u64)lsn * m_blocksize + m_offset;
+
+		if (ofs < m_xz->written)
+			throw Exception::BadStream(m_filename).SetDiagMsg(pxsFmt(L"Sector %u was written out of order to a compressed image", lsn));
+
+		// Fill skipped sectors
+		while (m_xz->written < ofs)
+			WriteCompressed(zeros, std::min<u64>(sizeof(zeros), ofs - m_xz->written));
+
+		WriteCompressed(src + m_blockofs, m_blocksize);
+		return;
+	}
 	else
 	{
 		wxFileOffset ofs = (wxFileOffset)lsn * m_blocksize + m_offset;
@@ -108,13 +151,74 @@ void OutputIsoFile::WriteSector(const u8* src, uint lsn)
 	WriteBuffer(src + m_blockofs, m_blocksize);
 }
 
+bool OutputIsoFile::WriteImage(InputIsoFile& src, const std::atomic<bool>* cancel)
+{
+	u8 buffer[CD_FRAMESIZE_RAW];
+	const uint blocks = src.GetBlockCount();
+
+	WriteHeader(src.GetBlockOffset(), src.GetBlockSize(), blocks);
+
+	for (uint lsn = 0; lsn < blocks; lsn++)
+	{
+		if (cancel && cancel->load(std::memory_order_relaxed))
+			return false;
+
+		const int read = src.ReadSync(buffer, lsn);
+		if (read < 0)
+			throw Exception::BadStream(src.GetFilename()).SetDiagMsg(pxsFmt(L"Unable to read sector %u", lsn));
+		if (read == 0)
+			break; // end of an image whose size was only estimated (gzip)
+
+		WriteSector(buffer, lsn);
+	}
+	return true;
+}
+
 void OutputIsoFile::Close()
 {
+	if (m_xz)
+	{
+		try
+		{
+			WriteCompressed(NULL, 0, true);
+		}
+		catch (BaseException& ex)
+		{
+			log_cb(RETRO_LOG_ERROR, "%s\n", WX_STR(ex.FormatDiagnosticMessage()));
+		}
+
+		lzma_end(&m_xz->strm);
+		m_xz.reset();
+		m_outstream.reset();
+	}
+
 	m_dtable.clear();
 
 	_init();
 }
 
+void OutputIsoFile::WriteCompressed(const void* src, size_t size, bool finish)
+{
+	lzma_stream& strm = m_xz->strm;
+	strm.next_in = (const u8*)src;
+	strm.avail_in = size;
+
+	lzma_ret ret;
+	do
+	{
+		strm.next_out = m_xz->out;
+		strm.avail_out = sizeof(m_xz->out);
+
+		ret = lzma_code(&strm, finish ? LZMA_FINISH : LZMA_RUN);
+		if (ret != LZMA_OK && ret != LZMA_STREAM_END)
+			throw Exception::BadStream(m_filename).SetDiagMsg(pxsFmt(L"xz compression failed (%d)", (int)ret));
+
+		WriteBuffer(m_xz->out, sizeof(m_xz->out) - strm.avail_out);
+	} while (strm.avail_in || (finish && ret != LZMA_STREAM_END));
+
+	m_xz->written += size;
+}
+
 void OutputIsoFile::WriteBuffer(const void* src, size_t size)
 {
 	m_outstream->Write(src, size);
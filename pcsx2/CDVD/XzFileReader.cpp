@@ -0,0 +1,328 @@
+/*  PCSX2 - PS2 Emulator for PCs
+*  Copyright (C) 2002-2021  PCSX2 Dev Team
+*
+*  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+*  of the GNU Lesser General Public License as published by the Free Software Found-
+*  ation, either version 3 of the License, or (at your option) any later version.
+*
+*  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+*  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+*  PURPOSE.  See the GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License along with PCSX2.
+*  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "PrecompiledHeader.h"
+#include "AsyncFileReader.h"
+#include "CompressedFileReaderUtils.h"
+#include "XzFileReader.h"
+
+#include <algorithm>
+#include <lzma.h>
+
+static const u8 XZ_MAGIC[6] = {0xFD, '7', 'z', 'X', 'Z', 0x00};
+
+bool XzFileReader::CanHandle(const wxString& fileName)
+{
+	bool supported = false;
+	if (wxFileName::FileExists(fileName) && fileName.Lower().EndsWith(L".xz"))
+	{
+		FILE* fp = PX_fopen_rb(fileName);
+		u8 magic[sizeof(XZ_MAGIC)];
+		if (fp)
+		{
+			if (fread(magic, 1, sizeof(magic), fp) == sizeof(magic))
+			{
+				supported = memcmp(magic, XZ_MAGIC, sizeof(magic)) == 0;
+			}
+			fclose(fp);
+		}
+	}
+	return supported;
+}
+
+XzFileReader::XzFileReader(void)
+	: m_totalSize(0)
+	, m_src(0)
+	, m_bytesRead(0)
+{
+	m_blocksize = 2048;
+}
+
+bool XzFileReader::Open(const wxString& fileName)
+{
+	Close();
+	m_filename = fileName;
+	m_src = PX_fopen_rb(m_filename);
+
+	if (!m_src || !ReadIndex())
+	{
+		Close();
+		return false;
+	}
+
+	// Slots are as large as the largest block
+	u64 maxBlockSize = 0;
+	for (const BlockInfo& info : m_blocks)
+		maxBlockSize = std::max(maxBlockSize, info.uncompressedSize);
+
+	uint threads = DecodedBlockCache::GetDefaultThreadCount(XZ_MAX_DECODER_THREADS);
+	for (uint i = 0; i < threads; i++)
+	{
+		FILE* src = PX_fopen_rb(m_filename);
+		if (!src)
+			break;
+		m_workerSrc.push_back(src);
+	}
+
+	m_cache.Open(XZ_BLOCK_CACHE_SIZE, (uint)maxBlockSize, m_blocks.size(), m_workerSrc.size(),
+		[this](uint decoder, u32 block, u8* dest) { return DecodeBlock(decoder ? m_workerSrc[decoder - 1] : m_src, block, dest); });
+	return true;
+}
+
+// Walks the streams of the file from its end (like "xz --list" does), and
+// flattens their indexes into m_blocks.
+bool XzFileReader::ReadIndex()
+{
+	if (PX_fseeko(m_src, 0, SEEK_END) != 0)
+		return false;
+
+	s64 pos = PX_ftello(m_src);
+	std::vector<BlockInfo> blocks;
+	std::vector<u8> buffer;
+
+	while (pos > 0)
+	{
+		// Skip the stream padding (null 32-bit words)
+		u8 footer[LZMA_STREAM_HEADER_SIZE];
+		do
+		{
+			if (pos < 2 * LZMA_STREAM_HEADER_SIZE || PX_fseeko(m_src, pos - 4, SEEK_SET) != 0 ||
+				fread(footer, 1, 4, m_src) != 4)
+			{
+				log_cb(RETRO_LOG_ERROR, "XZ image is truncated.\n");
+				return false;
+			}
+			if (!footer[0] && !footer[1] && !footer[2] && !footer[3])
+				pos -= 4;
+			else
+				break;
+		} while (true);
+
+		lzma_stream_flags footerFlags;
+		if (PX_fseeko(m_src, pos - LZMA_STREAM_HEADER_SIZE, SEEK_SET) != 0 ||
+			fread(footer, 1, sizeof(footer), m_src) != sizeof(footer) ||
+			lzma_stream_footer_decode(&footerFlags, footer) != LZMA_OK)
+		{
+			log_cb(RETRO_LOG_ERROR, "XZ image has an invalid stream footer.\n");
+			return false;
+		}
+
+		const s64 indexPos = pos - LZMA_STREAM_HEADER_SIZE - footerFlags.backward_size;
+		if (indexPos < LZMA_STREAM_HEADER_SIZE)
+		{
+			log_cb(RETRO_LOG_ERROR, "XZ image has an invalid index size.\n");
+			return false;
+		}
+
+		buffer.resize(footerFlags.backward_size);
+		lzma_index* index = NULL;
+		uint64_t memlimit = UINT64_MAX;
+		size_t inPos = 0;
+		if (PX_fseeko(m_src, indexPos, SEEK_SET) != 0 ||
+			fread(buffer.data(), 1, buffer.size(), m_src) != buffer.size() ||
+			lzma_index_buffer_decode(&index, &memlimit, NULL, buffer.data(), &inPos, buffer.size()) != LZMA_OK)
+		{
+			log_cb(RETRO_LOG_ERROR, "Unable to read the XZ image index.\n");
+			return false;
+		}
+
+		// Stream start, blocks are listed relative to it
+		const s64 streamPos = pos - (s64)lzma_index_stream_size(index);
+
+		u8 header[LZMA_STREAM_HEADER_SIZE];
+		lzma_stream_flags headerFlags;
+		if (streamPos < 0 || PX_fseeko(m_src, streamPos, SEEK_SET) != 0 ||
+			fread(header, 1, sizeof(header), m_src) != sizeof(header) ||
+			lzma_stream_header_decode(&headerFlags, header) != LZMA_OK ||
+			lzma_stream_flags_compare(&headerFlags, &footerFlags) != LZMA_OK)
+		{
+			log_cb(RETRO_LOG_ERROR, "XZ image has an invalid stream header.\n");
+			lzma_index_end(index, NULL);
+			return false;
+		}
+
+		std::vector<BlockInfo> streamBlocks;
+		lzma_index_iter iter;
+		lzma_index_iter_init(&iter, index);
+		while (!lzma_index_iter_next(&iter, LZMA_INDEX_ITER_BLOCK))
+		{
+			BlockInfo info;
+			info.uncompressedOffset = iter.block.uncompressed_stream_offset;
+			info.uncompressedSize = iter.block.uncompressed_size;
+			info.compressedOffset = streamPos + iter.block.compressed_stream_offset;
+			info.totalSize = iter.block.total_size;
+			info.unpaddedSize = iter.block.unpadded_size;
+			info.check = headerFlags.check;
+			streamBlocks.push_back(info);
+		}
+		lzma_index_end(index, NULL);
+
+		// Streams are found last to first
+		blocks.insert(blocks.begin(), streamBlocks.begin(), streamBlocks.end());
+		pos = streamPos;
+	}
+
+	// Make the uncompressed offsets relative to the whole file
+	m_totalSize = 0;
+	for (BlockInfo& info : blocks)
+	{
+		if (info.uncompressedSize > XZ_MAX_BLOCK_SIZE)
+		{
+			log_cb(RETRO_LOG_ERROR, "XZ image blocks are too large for random access, recompress it with e.g. \"xz -T0 --block-size=2MiB\".\n");
+			return false;
+		}
+
+		info.uncompressedOffset = m_totalSize;
+		m_totalSize += info.uncompressedSize;
+	}
+
+	m_blocks.swap(blocks);
+	return !m_blocks.empty();
+}
+
+u32 XzFileReader::FindBlock(u64 pos) const
+{
+	auto it = std::upper_bound(m_blocks.begin(), m_blocks.end(), pos,
+		[](u64 pos, const BlockInfo& info) { return pos < info.uncompressedOffset; });
+
+	return (u32)(it - m_blocks.begin()) - 1;
+}
+
+bool XzFileReader::DecodeBlock(FILE* src, u32 block, u8* dest)
+{
+	const BlockInfo& info = m_blocks[block];
+
+	std::vector<u8> compressed(info.totalSize);
+	if (PX_fseeko(src, info.compressedOffset, SEEK_SET) != 0 ||
+		fread(compressed.data(), 1, compressed.size(), src) != compressed.size())
+	{
+		log_cb(RETRO_LOG_ERROR, "Unable to read XZ block.\n");
+		return false;
+	}
+
+	lzma_filter filters[LZMA_FILTERS_MAX + 1];
+	lzma_block header = {};
+	header.version = 0;
+	header.check = (lzma_check)info.check;
+	header.filters = filters;
+	header.header_size = lzma_block_header_size_decode(compressed[0]);
+
+	if (header.header_size > compressed.size() || lzma_block_header_decode(&header, NULL, compressed.data()) != LZMA_OK)
+	{
+		log_cb(RETRO_LOG_ERROR, "Unable to decode XZ block header.\n");
+		return false;
+	}
+
+	size_t inPos = header.header_size;
+	size_t outPos = 0;
+	lzma_ret ret = lzma_block_compressed_size(&header, info.unpaddedSize);
+	if (ret == LZMA_OK)
+		ret = lzma_block_buffer_decode(&header, NULL, compressed.data(), &inPos, compressed.size(), dest, &outPos, info.uncompressedSize);
+
+	for (int i = 0; filters[i].id != LZMA_VLI_UNKNOWN; i++)
+		free(filters[i].options);
+
+	if (ret != LZMA_OK || outPos != info.uncompressedSize)
+	{
+		log_cb(RETRO_LOG_ERROR, "Unable to decompress XZ block (%d).\n", (int)ret);
+		return false;
+	}
+
+	return true;
+}
+
+int XzFileReader::ReadFromBlock(u8* dest, u64 pos, int maxBytes)
+{
+	if (pos >= m_totalSize)
+	{
+		// Can't read anything passed the end.
+		return 0;
+	}
+
+	const u32 block = FindBlock(pos);
+	const BlockInfo& info = m_blocks[block];
+	const u64 offset = pos - info.uncompressedOffset;
+	const int bytes = (int)std::min<u64>(maxBytes, info.uncompressedSize - offset);
+
+	const u8* data = m_cache.Get(block);
+	if (!data)
+		return 0;
+
+	memcpy(dest, data + offset, bytes);
+
+	// Sequential streams will most likely want the next block soon
+	m_cache.Prefetch(block + 1, block + 1);
+	return bytes;
+}
+
+int XzFileReader::ReadSync(void* pBuffer, uint sector, uint count)
+{
+	if (!m_src)
+	{
+		return 0;
+	}
+
+	u8* dest = (u8*)pBuffer;
+	u64 pos = (u64)sector * (u64)m_blocksize + m_dataoffset;
+	int remaining = count * m_blocksize;
+	int bytes = 0;
+
+	while (remaining > 0)
+	{
+		int readBytes = ReadFromBlock(dest + bytes, pos + bytes, remaining);
+		if (readBytes == 0)
+		{
+			// We hit EOF.
+			break;
+		}
+
+		bytes += readBytes;
+		remaining -= readBytes;
+	}
+
+	return bytes;
+}
+
+void XzFileReader::BeginRead(void* pBuffer, uint sector, uint count)
+{
+	// No async support yet, implement as sync.
+	m_bytesRead = ReadSync(pBuffer, sector, count);
+}
+
+int XzFileReader::FinishRead()
+{
+	int res = m_bytesRead;
+	m_bytesRead = -1;
+	return res;
+}
+
+void XzFileReader::Close()
+{
+	m_cache.Close();
+	for (FILE* src : m_workerSrc)
+		fclose(src);
+	m_workerSrc.clear();
+
+	m_filename.Empty();
+
+	if (m_src)
+	{
+		fclose(m_src);
+		m_src = NULL;
+	}
+
+	m_blocks.clear();
+	m_totalSize = 0;
+}
@@ -0,0 +1,90 @@
+/*  PCSX2 - PS2 Emulator for PCs
+*  Copyright (C) 2002-2021  PCSX2 Dev Team
+*
+*  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+*  of the GNU Lesser General Public License as published by the Free Software Found-
+*  ation, either version 3 of the License, or (at your option) any later version.
+*
+*  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+*  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+*  PURPOSE.  See the GNU General Public License for more details.
+*
+*  You should have received a copy of the GNU General Public License along with PCSX2.
+*  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+// Reads .xz compressed images which were split into independent blocks, like
+// the ones written by OutputIsoFile in compressed mode, or by
+// "xz -T0 --block-size=2MiB". The index at the end of each xz stream gives the
+// location of every block, so any of them can be decoded on its own.
+//
+// Blocks are decoded into a DecodedBlockCache, and the block following the last
+// one read is decoded ahead for sequential streams.
+
+#include <vector>
+
+#include "AsyncFileReader.h"
+#include "DecodedBlockCache.h"
+
+static const uint XZ_BLOCK_CACHE_SIZE = 4;               // decoded blocks kept around
+static const uint XZ_MAX_DECODER_THREADS = 1;            // only the next block is decoded ahead
+static const u64 XZ_MAX_BLOCK_SIZE = 64 * 1024 * 1024;   // larger blocks aren't seekable enough
+static const u64 XZ_OUTPUT_BLOCK_SIZE = 2 * 1024 * 1024; // block size used by OutputIsoFile
+
+class XzFileReader : public AsyncFileReader
+{
+	DeclareNoncopyableObject(XzFileReader);
+
+public:
+	XzFileReader(void);
+	virtual ~XzFileReader(void) { Close(); };
+
+	static bool CanHandle(const wxString& fileName);
+	virtual bool Open(const wxString& fileName);
+
+	virtual int ReadSync(void* pBuffer, uint sector, uint count);
+
+	virtual void BeginRead(void* pBuffer, uint sector, uint count);
+	virtual int FinishRead(void);
+	virtual void CancelRead(void){};
+
+	virtual void Close(void);
+
+	virtual uint GetBlockCount(void) const
+	{
+		return (m_totalSize - m_dataoffset) / m_blocksize;
+	};
+
+	virtual void SetBlockSize(uint bytes) { m_blocksize = bytes; }
+	virtual void SetDataOffset(int bytes) { m_dataoffset = bytes; }
+
+private:
+	struct BlockInfo
+	{
+		u64 uncompressedOffset;
+		u64 uncompressedSize;
+		u64 compressedOffset;
+		u64 totalSize;    // including header and padding
+		u64 unpaddedSize; // as stored in the index
+		u32 check;        // lzma_check of the stream holding this block
+	};
+
+	bool ReadIndex();
+	u32 FindBlock(u64 pos) const;
+	bool DecodeBlock(FILE* src, u32 block, u8* dest);
+	int ReadFromBlock(u8* dest, u64 pos, int maxBytes);
+
+	std::vector<BlockInfo> m_blocks;
+	u64 m_totalSize;
+	FILE* m_src;
+
+	// Decoded blocks, and a file handle for each of the cache workers (the
+	// reader uses m_src)
+	DecodedBlockCache m_cache;
+	std::vector<FILE*> m_workerSrc;
+
+	// The result of a read is stored here between BeginRead() and FinishRead().
+	int m_bytesRead;
+};
@@ -49,6 +49,8 @@ Comments) 1950 to 1952 in the files http://tools.ietf.org/html/rfc1950
       (Thanks to Mark Adler for suggesting the approach)
   - build_index(...) - added progress prints
   - CHUNK changed from 16k to 512k
+  - build_index_async(...) - build_index with the partial index published while it's built,
+      so that extract(...) can serve reads before the whole stream was scanned
  */
 
 /* Illustrate the use of Z_BLOCK, inflatePrime(), and inflateSetDictionary()
@@ -216,6 +218,22 @@ local struct access* addpoint(struct access* index, int bits,
 	return index;
 }
 
+/* Hooks which let another thread use the index while build_index_async() is
+   still adding access points to it.  lock/unlock are held while *built is
+   modified (new access point, final trim or error), abort is polled once per
+   CHUNK of input and stops the build with Z_INDEX_ABORTED when non zero. */
+typedef struct index_hooks
+{
+	void* opaque;
+	void (*lock)(void* opaque);
+	void (*unlock)(void* opaque);
+	int (*abort)(void* opaque);
+} Index_hooks;
+
+#define Z_INDEX_ABORTED (-100)
+
+local int build_index_async(FILE* in, PX_off_t span, struct access** built, const struct index_hooks* hooks);
+
 /* Make one entire pass through the compressed stream and build an index, with
    access points about every span bytes of uncompressed output -- span is
    chosen to balance the speed of random access against the memory requirements
@@ -225,6 +243,14 @@ local struct access* addpoint(struct access* index, int bits,
    of memory, Z_DATA_ERROR for an error in the input file, or Z_ERRNO for a
    file read error.  On success, *built points to the resulting index. */
 local int build_index(FILE* in, PX_off_t span, struct access** built)
+{
+	return build_index_async(in, span, built, NULL);
+}
+
+/* Same as build_index(), but *built (which must be NULL on entry) always points
+   to the access points found so far, and is only modified while hooks->lock is
+   held.  The index is freed and *built reset to NULL on error. */
+local int build_index_async(FILE* in, PX_off_t span, struct access** built, const struct index_hooks* hooks)
 {
 	int ret;
 	PX_off_t totin, totout, totPrinted; /* our own total counters to avoid 4GB limit */
@@ -252,6 +278,13 @@ local int build_index(FILE* in, PX_off_t span, struct access** built)
 	strm.avail_out = 0;
 	do
 	{
+		if (hooks && hooks->abort(hooks->opaque))
+		{
+			ret = Z_INDEX_ABORTED;
+			goto build_index_error;
+		}
+
+
 		/* get some compressed data from input file */
 		strm.avail_in = fread(input, 1, CHUNK, in);
 		if (ferror(in))
@@ -302,8 +335,20 @@ local int build_index(FILE* in, PX_off_t span, struct access** built)
 			if ((strm.data_type & 128) && !(strm.data_type & 64) &&
 				(totout == 0 || totout - last > span))
 			{
+				if (hooks)
+					hooks->lock(hooks->opaque);
 				index = addpoint(index, strm.data_type & 7, totin,
 								 totout, strm.avail_out, window);
+				if (hooks)
+				{
+					if (index)
+					{
+						index->span = span;
+						index->uncompressed_size = 0; /* unknown until the end of the stream */
+					}
+					*built = index;
+					hooks->unlock(hooks->opaque);
+				}
 				if (index == NULL)
 				{
 					ret = Z_MEM_ERROR;
@@ -327,18 +372,29 @@ local int build_index(FILE* in, PX_off_t span, struct access** built)
 
 	/* clean up and return index (release unused entries in list) */
 	(void)inflateEnd(&strm);
+	if (hooks)
+		hooks->lock(hooks->opaque);
 	index->list = (Point*)realloc(index->list, sizeof(struct point) * index->have);
 	index->size = index->have;
 	index->span = span;
 	index->uncompressed_size = totout;
 	*built = index;
+	if (hooks)
+		hooks->unlock(hooks->opaque);
 	return index->have;
 
 	/* return error */
 build_index_error:
 	(void)inflateEnd(&strm);
+	if (hooks)
+		hooks->lock(hooks->opaque);
 	if (index != NULL)
 		free_index(index);
+	if (hooks)
+	{
+		*built = NULL;
+		hooks->unlock(hooks->opaque);
+	}
 	return ret;
 }
 
@@ -240,7 +240,9 @@ struct Pcsx2Config
 				WaitLoop		:1,		// enables constant loop detection and fast-forwarding
 				vuFlagHack		:1,		// microVU specific flag hack
 				vuThread : 1,		// Enable Threaded VU1
-				vu1Instant : 1;		// Enable Instant VU1 (Without MTVU only)
+				vu1Instant : 1,		// Enable Instant VU1 (Without MTVU only)
+				IopHLE : 1,		// Run native versions of hot IOP module exports (see IopBios.cpp)
+				vu0Thread : 1;		// Run VU0 micro programs on their own thread (see VU0_Thread in MTVU.h)
 		BITFIELD_END
 
 		s8	EECycleRate;		// EE cycle rate selector (1.0, 1.5, 2.0)
@@ -325,6 +327,7 @@ Pcsx2Config::GamefixOptions&	SetGameFixConfig();
 // ------------ CPU / Recompiler Options ---------------
 
 #define THREAD_VU1					(EmuConfig.Cpu.Recompiler.EnableVU1 && EmuConfig.Speedhacks.vuThread)
+#define THREAD_VU0					(EmuConfig.Cpu.Recompiler.EnableEE && EmuConfig.Cpu.Recompiler.EnableVU0 && EmuConfig.Speedhacks.vu0Thread)
 #define INSTANT_VU1					(EmuConfig.Speedhacks.vu1Instant)
 #define CHECK_EEREC					(EmuConfig.Cpu.Recompiler.EnableEE && GetCpuProviders().IsRecAvailable_EE())
 #define CHECK_IOPREC				(EmuConfig.Cpu.Recompiler.EnableIOP && GetCpuProviders().IsRecAvailable_IOP())
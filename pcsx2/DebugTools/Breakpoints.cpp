@@ -18,6 +18,7 @@
 #include "SymbolMap.h"
 #include "MIPSAnalyst.h"
 #include <cstdio>
+#include <atomic>
 #include "../R5900.h"
 #include "../System.h"
 
@@ -28,6 +29,15 @@ std::vector<MemCheck> CBreakPoints::memChecks_;
 std::vector<MemCheck *> CBreakPoints::cleanupMemChecks_;
 bool CBreakPoints::breakpointTriggered_ = false;
 
+struct MemCheckTrees
+{
+	IntervalTree<MemCheckResult> loads;
+	IntervalTree<MemCheckResult> stores;
+};
+
+static const MemCheckTrees emptyMemCheckTrees;
+static std::atomic<const MemCheckTrees*> memCheckTrees_(&emptyMemCheckTrees);
+
 // called from the dynarec
 u32 __fastcall standardizeBreakpointAddress(u32 addr)
 {
@@ -381,6 +391,36 @@ const std::vector<BreakPoint> CBreakPoints::GetBreakpoints()
 	return breakPoints_;
 }
 
+const IntervalTree<MemCheckResult>& CBreakPoints::GetMemCheckTree(bool store)
+{
+	const MemCheckTrees* trees = memCheckTrees_.load(std::memory_order_acquire);
+	return store ? trees->stores : trees->loads;
+}
+
+void CBreakPoints::UpdateMemCheckTrees()
+{
+	MemCheckTrees* trees = new MemCheckTrees;
+	for (auto it = memChecks_.begin(), itend = memChecks_.end(); it != itend; ++it)
+	{
+		if (it->result == 0)
+			continue;
+
+		u32 start = standardizeBreakpointAddress(it->start);
+		u32 end = standardizeBreakpointAddress(it->end);
+		if (it->cond & MEMCHECK_READ)
+			trees->loads.Add(start, end, it->result);
+		if (it->cond & MEMCHECK_WRITE)
+			trees->stores.Add(start, end, it->result);
+	}
+	trees->loads.Build();
+	trees->stores.Build();
+
+	// Only the cpu thread reads the trees and it's paused, the old ones can go right away
+	const MemCheckTrees* old = memCheckTrees_.exchange(trees, std::memory_order_acq_rel);
+	if (old != &emptyMemCheckTrees)
+		delete old;
+}
+
 // including them earlier causes some ambiguities
 #include "App.h"
 void CBreakPoints::Update(u32 addr)
@@ -392,6 +432,8 @@ void CBreakPoints::Update(u32 addr)
 		resume = true;
 	}
 
+	UpdateMemCheckTrees();
+
 //	if (addr != 0)
 //		Cpu->Clear(addr-4,8);
 //	else
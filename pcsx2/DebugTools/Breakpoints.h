@@ -20,6 +20,7 @@
 #include <vector>
 
 #include "DebugInterface.h"
+#include "IntervalTree.h"
 #include "Pcsx2Types.h"
 
 struct BreakPointCond
@@ -143,6 +144,10 @@ public:
 	static const std::vector<BreakPoint> GetBreakpoints();
 	static size_t GetNumMemchecks() { return memChecks_.size(); }
 
+	// Memchecks hit by loads or stores, with standardized addresses.  Swapped in by
+	// Update() while the cpu is paused, so the cpu cores can query it without locking.
+	static const IntervalTree<MemCheckResult>& GetMemCheckTree(bool store);
+
 	static void Update(u32 addr = 0);
 
 	static void SetBreakpointTriggered(bool b) { breakpointTriggered_ = b; };
@@ -152,6 +157,7 @@ private:
 	static size_t FindBreakpoint(u32 addr, bool matchTemp = false, bool temp = false);
 	// Finds exactly, not using a range check.
 	static size_t FindMemCheck(u32 start, u32 end);
+	static void UpdateMemCheckTrees();
 
 	static std::vector<BreakPoint> breakPoints_;
 	static u32 breakSkipFirstAt_;
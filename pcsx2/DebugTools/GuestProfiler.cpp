@@ -0,0 +1,233 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2014  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PrecompiledHeader.h"
+#include "Common.h"
+#include "R3000A.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "GuestProfiler.h"
+#include "DebugInterface.h"
+#include "MipsStackWalk.h"
+#include "SymbolMap.h"
+
+namespace GuestProfiler
+{
+
+std::atomic<bool> SampleRequested(false);
+
+struct BlockSamples
+{
+	u32 samples;
+	u32 size;
+	u32 intcalls;
+};
+
+// Only every Nth sample walks the stack; the scan for frame info is far more expensive
+// than recording a pc.
+static const u32 StackSampleInterval = 8;
+static const size_t DumpTopCount = 64;
+// Bounds of a stack walk, so a sample without symbols doesn't scan megabytes of code.
+static const u32 StackScanBytes = 4 * 1024;
+static const size_t StackMaxDepth = 16;
+
+static std::mutex s_lock;
+static std::unordered_map<u32, u32> s_eeSamples;			// ee pc -> samples
+static std::unordered_map<u32, u32> s_iopSamples;			// iop pc -> samples
+static std::unordered_map<u32, BlockSamples> s_blockSamples;	// rec block start -> samples
+static std::map<std::vector<u32>, u32> s_stackSamples;		// function entries, outermost first
+static u32 s_sampleCount = 0;
+static u32 s_stackTick = 0;			// EE thread only
+
+static std::thread s_timer;
+static std::atomic<bool> s_running(false);
+
+// The stack walk runs on the EE thread in the middle of the guest's code, so it
+// reads memory without going through the handlers: with the interpreter a TLB miss
+// would raise a guest exception and cancel the current instruction.
+class SampleDebugInterface : public R5900DebugInterface
+{
+public:
+	virtual u32 read32(u32 address)
+	{
+		const u32* ptr = address % 4 ? NULL : (const u32*)vtlb_GetVirtPtr(address);
+		return ptr ? *ptr : -1;
+	}
+
+	virtual bool isValidAddress(u32 address)
+	{
+		return vtlb_GetVirtPtr(address) != NULL;
+	}
+};
+
+static SampleDebugInterface s_sampleDebug;
+
+void Start(uint samplesPerSecond)
+{
+	if (s_running.exchange(true)) return;
+
+	const auto period = std::chrono::microseconds(1000000 / std::max(samplesPerSecond, 1u));
+	s_timer = std::thread([period]() {
+		while (s_running.load(std::memory_order_relaxed))
+		{
+			std::this_thread::sleep_for(period);
+			SampleRequested.store(true, std::memory_order_relaxed);
+		}
+	});
+}
+
+void Stop()
+{
+	if (!s_running.exchange(false)) return;
+
+	s_timer.join();
+	SampleRequested.store(false, std::memory_order_relaxed);
+}
+
+bool IsRunning()
+{
+	return s_running.load(std::memory_order_relaxed);
+}
+
+void Reset()
+{
+	std::lock_guard<std::mutex> guard(s_lock);
+	s_eeSamples.clear();
+	s_iopSamples.clear();
+	s_blockSamples.clear();
+	s_stackSamples.clear();
+	s_sampleCount = 0;
+}
+
+void TakeSample()
+{
+	SampleRequested.store(false, std::memory_order_relaxed);
+
+	const u32 pc = cpuRegs.pc;
+
+	BlockSamples block = {};
+	u32 blockStart = 0;
+	const bool inBlock = Cpu == &recCpu && recLookupBlock(pc, blockStart, block.size, block.intcalls);
+
+	std::vector<u32> stack;
+	if (s_stackTick++ % StackSampleInterval == 0)
+	{
+		auto frames = MipsStackWalk::Walk(&s_sampleDebug, pc, cpuRegs.GPR.n.ra.UL[0], cpuRegs.GPR.n.sp.UL[0], 0, 0,
+			StackScanBytes, StackMaxDepth);
+		stack.reserve(frames.size());
+		for (auto it = frames.rbegin(); it != frames.rend(); ++it)
+			stack.push_back(it->entry);
+	}
+
+	std::lock_guard<std::mutex> guard(s_lock);
+	s_sampleCount++;
+	s_eeSamples[pc]++;
+	s_iopSamples[psxRegs.pc]++;
+
+	if (inBlock)
+	{
+		BlockSamples& stats = s_blockSamples[blockStart];
+		stats.samples++;
+		stats.size = block.size;
+		stats.intcalls = block.intcalls;
+	}
+
+	if (!stack.empty())
+		s_stackSamples[stack]++;
+}
+
+static std::string SymbolName(u32 address)
+{
+	std::string label = symbolMap.GetLabelString(address);
+	if (!label.empty()) return label;
+
+	char buf[16];
+	snprintf(buf, sizeof(buf), "%08x", address);
+	return buf;
+}
+
+template< typename Key, typename Value, typename Count >
+static std::vector<std::pair<Key, Value>> SortedBy(const std::unordered_map<Key, Value>& table, Count count)
+{
+	std::vector<std::pair<Key, Value>> sorted(table.begin(), table.end());
+	std::sort(sorted.begin(), sorted.end(), [&](const std::pair<Key, Value>& a, const std::pair<Key, Value>& b) {
+		return count(a.second) > count(b.second);
+	});
+	return sorted;
+}
+
+bool Dump(const char* filename)
+{
+	FILE* fp = fopen(filename, "w");
+	if (!fp) return false;
+
+	std::lock_guard<std::mutex> guard(s_lock);
+	const double scale = s_sampleCount ? 100.0 / s_sampleCount : 0.0;
+
+	// Flat profile, pcs folded into the function containing them when one is known
+	std::unordered_map<u32, u32> functions;
+	for (const auto& sample : s_eeSamples)
+	{
+		u32 start = symbolMap.GetFunctionStart(sample.first);
+		functions[start != SymbolMap::INVALID_ADDRESS ? start : sample.first] += sample.second;
+	}
+
+	fprintf(fp, "EE samples: %u\n\n", s_sampleCount);
+	fprintf(fp, "-- EE functions --\n%10s %7s  %-8s  %s\n", "samples", "%", "address", "name");
+	for (const auto& func : SortedBy(functions, [](u32 n) { return n; }))
+		fprintf(fp, "%10u %6.2f%%  %08x  %s\n", func.second, func.second * scale, func.first, SymbolName(func.first).c_str());
+
+	fprintf(fp, "\n-- EE recompiled blocks (top %u) --\n%10s %7s  %-8s %6s %8s  %s\n", (uint)DumpTopCount,
+		"samples", "%", "start", "insns", "intcalls", "function");
+	auto blocks = SortedBy(s_blockSamples, [](const BlockSamples& b) { return b.samples; });
+	for (size_t i = 0; i < blocks.size() && i < DumpTopCount; i++)
+	{
+		const BlockSamples& stats = blocks[i].second;
+		u32 func = symbolMap.GetFunctionStart(blocks[i].first);
+		fprintf(fp, "%10u %6.2f%%  %08x %6u %8u  %s\n", stats.samples, stats.samples * scale, blocks[i].first,
+			stats.size, stats.intcalls, func != SymbolMap::INVALID_ADDRESS ? SymbolName(func).c_str() : "");
+	}
+
+	fprintf(fp, "\n-- IOP pcs (top %u) --\n%10s %7s  %s\n", (uint)DumpTopCount, "samples", "%", "pc");
+	auto iop = SortedBy(s_iopSamples, [](u32 n) { return n; });
+	for (size_t i = 0; i < iop.size() && i < DumpTopCount; i++)
+		fprintf(fp, "%10u %6.2f%%  %08x\n", iop[i].second, iop[i].second * scale, iop[i].first);
+
+	// Folded stacks, one "outer;...;inner count" line each, as flame graph tools expect
+	fprintf(fp, "\n-- EE call stacks (every %u samples) --\n", StackSampleInterval);
+	for (const auto& stack : s_stackSamples)
+	{
+		std::string line;
+		for (u32 entry : stack.first)
+		{
+			if (!line.empty()) line += ';';
+			line += SymbolName(entry);
+		}
+		fprintf(fp, "%s %u\n", line.c_str(), stack.second);
+	}
+
+	fclose(fp);
+	return true;
+}
+
+}
@@ -0,0 +1,47 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2014  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "Pcsx2Types.h"
+
+// --------------------------------------------------------------------------------------
+//  GuestProfiler
+// --------------------------------------------------------------------------------------
+// Sampling profiler for guest code.  A timer thread raises SampleRequested at a fixed
+// rate and the EE thread takes the sample at its next event test, where the cpu state
+// and guest memory are consistent enough to walk the stack.  Samples are resolved
+// through the symbol map and the EE recompiler's block list when the profile is dumped.
+//
+namespace GuestProfiler
+{
+	extern std::atomic<bool> SampleRequested;
+
+	void Start(uint samplesPerSecond = 1000);
+	void Stop();
+	bool IsRunning();
+
+	// Drops every sample taken so far.
+	void Reset();
+
+	// Writes the flat, block and call-stack profiles.  Returns false if the file
+	// couldn't be created.
+	bool Dump(const char* filename);
+
+	// EE thread only.
+	void TakeSample();
+}
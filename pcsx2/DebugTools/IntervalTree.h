@@ -0,0 +1,124 @@
+/*  PCSX2 - PS2 Emulator for PCs
+ *  Copyright (C) 2002-2014  PCSX2 Dev Team
+ *
+ *  PCSX2 is free software: you can redistribute it and/or modify it under the terms
+ *  of the GNU Lesser General Public License as published by the Free Software Found-
+ *  ation, either version 3 of the License, or (at your option) any later version.
+ *
+ *  PCSX2 is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ *  without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ *  PURPOSE.  See the GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along with PCSX2.
+ *  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "Pcsx2Types.h"
+
+// --------------------------------------------------------------------------------------
+//  IntervalTree
+// --------------------------------------------------------------------------------------
+// Immutable set of [start, end) address ranges.  The ranges are kept sorted by start and
+// the array is walked as an implicit balanced tree (root in the middle), every node
+// caching the highest end found below it.  Built once, then only read, so any number of
+// threads can query it without locking; owners swap in a new tree when their data changes.
+//
+template< typename T >
+class IntervalTree
+{
+public:
+	struct Node
+	{
+		u32 start;
+		u64 end;
+		u64 maxEnd;
+		T value;
+	};
+
+	IntervalTree() {}
+
+	// Ranges with end <= start are dropped.
+	void Add(u32 start, u64 end, const T& value)
+	{
+		if (end <= start) return;
+
+		Node node;
+		node.start  = start;
+		node.end    = end;
+		node.maxEnd = end;
+		node.value  = value;
+		m_nodes.push_back(node);
+	}
+
+	// Must be called once all ranges have been added, before any query.
+	void Build()
+	{
+		std::sort(m_nodes.begin(), m_nodes.end(), [](const Node& a, const Node& b) {
+			return a.start < b.start;
+		});
+		BuildMax(0, m_nodes.size());
+	}
+
+	bool IsEmpty() const { return m_nodes.empty(); }
+	size_t GetSize() const { return m_nodes.size(); }
+	const std::vector<Node>& GetNodes() const { return m_nodes; }
+
+	// Calls func(node) for every range overlapping [start, end).
+	template< typename Func >
+	void ForEachOverlap(u32 start, u64 end, Func func) const
+	{
+		Query(0, m_nodes.size(), start, end, func);
+	}
+
+	// The overlapping range with the highest start, or NULL.
+	const Node* FindInnermost(u32 address) const
+	{
+		const Node* found = NULL;
+		ForEachOverlap(address, (u64)address + 1, [&](const Node& node) {
+			if (!found || node.start > found->start)
+				found = &node;
+		});
+		return found;
+	}
+
+private:
+	u64 BuildMax(size_t lo, size_t hi)
+	{
+		if (lo >= hi) return 0;
+
+		size_t mid = lo + (hi - lo) / 2;
+		u64 maxEnd = std::max(BuildMax(lo, mid), BuildMax(mid + 1, hi));
+		m_nodes[mid].maxEnd = std::max(m_nodes[mid].end, maxEnd);
+		return m_nodes[mid].maxEnd;
+	}
+
+	template< typename Func >
+	void Query(size_t lo, size_t hi, u32 start, u64 end, Func& func) const
+	{
+		while (lo < hi)
+		{
+			size_t mid = lo + (hi - lo) / 2;
+			const Node& node = m_nodes[mid];
+
+			// Nothing below this node reaches the range
+			if (node.maxEnd <= start) return;
+
+			Query(lo, mid, start, end, func);
+
+			// Everything right of here starts too late
+			if (node.start >= end) return;
+
+			if (node.end > start)
+				func(node);
+
+			lo = mid + 1;
+		}
+	}
+
+	std::vector<Node> m_nodes;
+};
@@ -40,6 +40,8 @@ namespace MipsStackWalk {
 	const int MAX_FUNC_SIZE = 32768 * 4;
 	// After this we assume we're stuck.
 	const size_t MAX_DEPTH = 1024;
+	// Let's hope there are no > 1MB functions on the PSP, for the sake of humanity...
+	const u32 LONGEST_FUNCTION = 1024 * 1024;
 
 	static u32 GuessEntry(u32 pc) {
 		SymbolInfo info;
@@ -96,9 +98,7 @@ namespace MipsStackWalk {
 		return false;
 	}
 
-	bool ScanForEntry(DebugInterface* cpu, StackFrame &frame, u32 entry, u32 &ra) {
-		// Let's hope there are no > 1MB functions on the PSP, for the sake of humanity...
-		const u32 LONGEST_FUNCTION = 1024 * 1024;
+	bool ScanForEntry(DebugInterface* cpu, StackFrame &frame, u32 entry, u32 &ra, u32 longestFunction) {
 		// TODO: Check if found entry is in the same symbol?  Might be wrong sometimes...
 
 		int ra_offset = -1;
@@ -114,8 +114,8 @@ namespace MipsStackWalk {
 			}*/
 			stop = 0x80000;
 		}
-		if (stop < start - LONGEST_FUNCTION) {
-			stop = start - LONGEST_FUNCTION;
+		if (stop < start - longestFunction) {
+			stop = start - longestFunction;
 		}
 		for (u32 pc = start; cpu->isValidAddress(pc) && pc >= stop; pc -= 4) {
 			u32 rawOp = cpu->read32(pc);
@@ -147,8 +147,8 @@ namespace MipsStackWalk {
 		return false;
 	}
 
-	bool DetermineFrameInfo(DebugInterface* cpu, StackFrame &frame, u32 possibleEntry, u32 threadEntry, u32 &ra) {
-		if (ScanForEntry(cpu, frame, possibleEntry, ra)) {
+	bool DetermineFrameInfo(DebugInterface* cpu, StackFrame &frame, u32 possibleEntry, u32 threadEntry, u32 &ra, u32 longestFunction) {
+		if (ScanForEntry(cpu, frame, possibleEntry, ra, longestFunction)) {
 			// Awesome, found one that looks right.
 			return true;
 		} else if (ra != INVALIDTARGET && possibleEntry != INVALIDTARGET) {
@@ -161,10 +161,14 @@ namespace MipsStackWalk {
 		// Okay, we failed to get one.  Our possibleEntry could be wrong, it often is.
 		// Let's just scan upward.
 		u32 newPossibleEntry = frame.pc > threadEntry ? threadEntry : frame.pc - MAX_FUNC_SIZE;
-		return ScanForEntry(cpu, frame, newPossibleEntry, ra);
+		return ScanForEntry(cpu, frame, newPossibleEntry, ra, longestFunction);
 	}
 
 	std::vector<StackFrame> Walk(DebugInterface* cpu, u32 pc, u32 ra, u32 sp, u32 threadEntry, u32 threadStackTop) {
+		return Walk(cpu, pc, ra, sp, threadEntry, threadStackTop, LONGEST_FUNCTION, MAX_DEPTH);
+	}
+
+	std::vector<StackFrame> Walk(DebugInterface* cpu, u32 pc, u32 ra, u32 sp, u32 threadEntry, u32 threadStackTop, u32 longestFunction, size_t maxDepth) {
 		std::vector<StackFrame> frames;
 		StackFrame current;
 		current.pc = pc;
@@ -175,12 +179,12 @@ namespace MipsStackWalk {
 		u32 prevEntry = INVALIDTARGET;
 		while (pc != threadEntry) {
 			u32 possibleEntry = GuessEntry(current.pc);
-			if (DetermineFrameInfo(cpu, current, possibleEntry, threadEntry, ra)) {
+			if (DetermineFrameInfo(cpu, current, possibleEntry, threadEntry, ra, longestFunction)) {
 				frames.push_back(current);
 				if (current.entry == threadEntry || GuessEntry(current.entry) == threadEntry) {
 					break;
 				}
-				if (current.entry == prevEntry || frames.size() >= MAX_DEPTH) {
+				if (current.entry == prevEntry || frames.size() >= maxDepth) {
 					// Recursion, means we're screwed.  Let's just give up.
 					break;
 				}
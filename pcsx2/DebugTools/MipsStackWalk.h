@@ -38,4 +38,7 @@ namespace MipsStackWalk {
 	};
 
 	std::vector<StackFrame> Walk(DebugInterface* cpu, u32 pc, u32 ra, u32 sp, u32 threadEntry, u32 threadStackTop);
+	// Same, but scanning at most longestFunction bytes back for each entry and
+	// returning at most maxDepth frames.
+	std::vector<StackFrame> Walk(DebugInterface* cpu, u32 pc, u32 ra, u32 sp, u32 threadEntry, u32 threadStackTop, u32 longestFunction, size_t maxDepth);
 };
@@ -41,6 +41,7 @@ void SymbolMap::Clear() {
 	activeData.clear();
 	activeModuleEnds.clear();
 	modules.clear();
+	InvalidateActiveRanges();
 }
 
 
@@ -324,6 +325,7 @@ std::vector<LoadedModuleInfo> SymbolMap::getAllModules() const {
 
 void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleIndex) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	InvalidateActiveRanges();
 
 	if (moduleIndex == -1) {
 		moduleIndex = GetModuleIndex(address);
@@ -368,6 +370,11 @@ void SymbolMap::AddFunction(const char* name, u32 address, u32 size, int moduleI
 }
 
 u32 SymbolMap::GetFunctionStart(u32 address) const {
+	if (std::shared_ptr<const RangeSnapshot> ranges = std::atomic_load(&activeRanges)) {
+		const auto* func = ranges->functions.FindInnermost(address);
+		return func ? func->start : INVALID_ADDRESS;
+	}
+
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	auto it = activeFunctions.upper_bound(address);
 	if (it == activeFunctions.end()) {
@@ -404,6 +411,11 @@ u32 SymbolMap::GetFunctionSize(u32 startAddress) const {
 }
 
 int SymbolMap::GetFunctionNum(u32 address) const {
+	if (std::shared_ptr<const RangeSnapshot> ranges = std::atomic_load(&activeRanges)) {
+		const auto* func = ranges->functions.FindInnermost(address);
+		return func ? func->value : INVALID_ADDRESS;
+	}
+
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	u32 start = GetFunctionStart(address);
 	if (start == INVALID_ADDRESS)
@@ -469,6 +481,28 @@ void SymbolMap::UpdateActiveSymbols() {
 	}
 
 	AssignFunctionIndices();
+	BuildActiveRanges();
+}
+
+void SymbolMap::BuildActiveRanges() {
+	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	std::shared_ptr<RangeSnapshot> ranges = std::make_shared<RangeSnapshot>();
+
+	for (auto it = activeFunctions.begin(), end = activeFunctions.end(); it != end; ++it) {
+		ranges->functions.Add(it->first, (u64)it->first + it->second.size, it->second.index);
+	}
+	for (auto it = activeData.begin(), end = activeData.end(); it != end; ++it) {
+		ranges->data.Add(it->first, (u64)it->first + it->second.size, it->second.type);
+	}
+
+	ranges->functions.Build();
+	ranges->data.Build();
+
+	std::atomic_store(&activeRanges, std::shared_ptr<const RangeSnapshot>(std::move(ranges)));
+}
+
+void SymbolMap::InvalidateActiveRanges() {
+	std::atomic_store(&activeRanges, std::shared_ptr<const RangeSnapshot>());
 }
 
 bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
@@ -490,6 +524,7 @@ bool SymbolMap::SetFunctionSize(u32 startAddress, u32 newSize) {
 
 bool SymbolMap::RemoveFunction(u32 startAddress, bool removeName) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	InvalidateActiveRanges();
 
 	auto it = activeFunctions.find(startAddress);
 	if (it == activeFunctions.end())
@@ -622,6 +657,7 @@ bool SymbolMap::GetLabelValue(const char* name, u32& dest) {
 
 void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
+	InvalidateActiveRanges();
 
 	if (moduleIndex == -1) {
 		moduleIndex = GetModuleIndex(address);
@@ -665,6 +701,11 @@ void SymbolMap::AddData(u32 address, u32 size, DataType type, int moduleIndex) {
 }
 
 u32 SymbolMap::GetDataStart(u32 address) const {
+	if (std::shared_ptr<const RangeSnapshot> ranges = std::atomic_load(&activeRanges)) {
+		const auto* entry = ranges->data.FindInnermost(address);
+		return entry ? entry->start : INVALID_ADDRESS;
+	}
+
 	std::lock_guard<std::recursive_mutex> guard(m_lock);
 	auto it = activeData.upper_bound(address);
 	if (it == activeData.end())
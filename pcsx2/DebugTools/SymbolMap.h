@@ -20,8 +20,10 @@
 #include <map>
 #include <string>
 #include <mutex>
+#include <memory>
 
 #include "Pcsx2Types.h"
+#include "IntervalTree.h"
 
 enum SymbolType {
 	ST_NONE     = 0,
@@ -98,6 +100,8 @@ public:
 	bool IsEmpty() const { return activeFunctions.empty() && activeLabels.empty() && activeData.empty(); };
 private:
 	void AssignFunctionIndices();
+	void BuildActiveRanges();
+	void InvalidateActiveRanges();
 	const char *GetLabelName(u32 address) const;
 	const char *GetLabelNameRel(u32 relAddress, int moduleIndex) const;
 
@@ -145,6 +149,17 @@ private:
 	std::map<SymbolKey, DataEntry> data;
 	std::vector<ModuleEntry> modules;
 
+	// Immutable copy of the active function and data ranges, rebuilt by UpdateActiveSymbols.
+	// GetFunctionStart and friends read it without taking the lock; while it's NULL (the
+	// maps were edited since) they fall back to the locked maps.  It's only accessed with
+	// std::atomic_load/atomic_store, lookups hold a reference so a replaced snapshot is freed
+	// once the last of them is done.
+	struct RangeSnapshot {
+		IntervalTree<int> functions;	// value is the function index
+		IntervalTree<DataType> data;
+	};
+	std::shared_ptr<const RangeSnapshot> activeRanges;
+
 	mutable std::recursive_mutex m_lock;
 };
 
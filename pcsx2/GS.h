@@ -347,6 +347,12 @@ public:
 	Semaphore			m_sem_OpenDone;
 	std::atomic<bool>	m_Opened;
 
+#ifdef __LIBRETRO__
+	// Frame stepped execution: the EE holds each vsync until StepFrame() allows it.
+	std::atomic<bool>	m_FrameStepping;
+	Semaphore			m_sem_FrameStep;
+#endif
+
 	// These vars maintain instance data for sending Data Packets.
 	// Only one data packet can be constructed and uploaded at a time.
 
@@ -385,6 +391,10 @@ public:
 
 	void ExecuteTaskInThread();
 	void FinishTaskInThread();
+#ifdef __LIBRETRO__
+	void StepFrame(bool frameStepping);
+	void WakeUp() { m_sem_event.Post(); }
+#endif
 	void OpenGS();
 	void CloseGS();
 
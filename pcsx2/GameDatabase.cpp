@@ -189,13 +189,26 @@ GameDatabaseSchema::GameEntry YamlGameDatabaseImpl::findGame(const std::string s
 {
 	std::string serialLower = strToLower(serial);
 	log_cb(RETRO_LOG_INFO, "[GameDB] Searching for '%s' in GameDB\n", serialLower.c_str());
-	if (gameDb.count(serialLower) == 1)
+	auto it = gameIndex.find(serialLower);
+	if (it != gameIndex.end())
 	{
 		log_cb(RETRO_LOG_INFO, "[GameDB] Found '%s' in GameDB\n", serialLower.c_str());
-		return gameDb[serialLower];
+		try
+		{
+			// The span is a complete single-key document, so only this entry is parsed
+			YAML::Node data = YAML::Load(std::string(gameData + it->second.offset, it->second.size));
+			for (const auto& entry : data)
+				return entryFromYaml(serialLower, entry.second);
+		} catch (const std::exception& e)
+		{
+			log_cb(RETRO_LOG_ERROR, "[GameDB] Invalid GameDB syntax detected on serial: '%s'. Error Details - %s\n", serialLower.c_str(), e.what());
+		}
+	}
+	else
+	{
+		log_cb(RETRO_LOG_ERROR, "[GameDB] Could not find '%s' in GameDB\n", serialLower.c_str());
 	}
 
-	log_cb(RETRO_LOG_ERROR, "[GameDB] Could not find '%s' in GameDB\n", serialLower.c_str());
 	GameDatabaseSchema::GameEntry entry;
 	entry.isValid = false;
 	return entry;
@@ -203,48 +216,66 @@ GameDatabaseSchema::GameEntry YamlGameDatabaseImpl::findGame(const std::string s
 
 int YamlGameDatabaseImpl::numGames()
 {
-	return gameDb.size();
+	return gameIndex.size();
 }
 
 bool YamlGameDatabaseImpl::initDatabase(std::istream& stream)
 {
-	try
+	if (!stream)
 	{
-		if (!stream)
-		{
-			log_cb(RETRO_LOG_ERROR, "[GameDB] Unable to open GameDB file.\n");
-			return false;
-		}
-		// yaml-cpp has memory leak issues if you persist and modify a YAML::Node
-		// convert to a map and throw it away instead!
-		YAML::Node data = YAML::Load(stream);
-		for (const auto& entry : data)
+		log_cb(RETRO_LOG_ERROR, "[GameDB] Unable to open GameDB file.\n");
+		return false;
+	}
+
+	ownedData.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+	return initDatabase(ownedData.data(), ownedData.size());
+}
+
+bool YamlGameDatabaseImpl::initDatabase(const char* data, size_t size)
+{
+	gameData = data;
+	gameIndex.clear();
+
+	// Every line starting in the first column that is not a comment is a top-level `serial:` key,
+	// block scalars and nested maps are always indented.  An entry runs until the next key.
+	std::string serial;
+	size_t start = 0;
+
+	for (size_t pos = 0; pos < size;)
+	{
+		const char* line = data + pos;
+		const char* eol = static_cast<const char*>(memchr(line, '\n', size - pos));
+		const size_t len = eol ? eol - line : size - pos;
+
+		if (len > 0 && line[0] != ' ' && line[0] != '\t' && line[0] != '#' && line[0] != '\r')
 		{
-			// we don't want to throw away the entire GameDB file if a single entry is made incorrectly,
-			// but we do want to yell about it so it can be corrected
-			try
+			const char* colon = static_cast<const char*>(memchr(line, ':', len));
+
+			if (colon)
 			{
+				if (!serial.empty())
+					gameIndex.emplace(serial, EntrySpan{start, pos - start});
+
 				// Serials and CRCs must be inserted as lower-case, as that is how they are retrieved
 				// this is because the application may pass a lowercase CRC or serial along
 				//
 				// However, YAML's keys are as expected case-sensitive, so we have to explicitly do our own duplicate checking
-				std::string serial = strToLower(entry.first.as<std::string>());
-				if (gameDb.count(serial) == 1)
+				serial = strToLower(std::string(line, colon - line));
+				start = pos;
+
+				if (gameIndex.count(serial) == 1)
 				{
 					log_cb(RETRO_LOG_ERROR, "[GameDB] Duplicate serial '%s' found in GameDB. Skipping, Serials are case-insensitive!\n", serial.c_str());
-					continue;
+					serial.clear();
 				}
-				gameDb[serial] = entryFromYaml(serial, entry.second);
-			} catch (const YAML::RepresentationException& e)
-			{
-				log_cb(RETRO_LOG_ERROR, "[GameDB] Invalid GameDB syntax detected. Error Details - %s\n", e.msg.c_str());
 			}
 		}
-	} catch (const std::exception& e)
-	{
-		log_cb(RETRO_LOG_ERROR, "[GameDB] Error occured when initializing GameDB: %s\n", e.what());
-		return false;
+
+		pos += len + 1;
 	}
 
+	if (!serial.empty())
+		gameIndex.emplace(serial, EntrySpan{start, size - start});
+
 	return true;
 }
@@ -91,15 +91,27 @@ public:
 	virtual int numGames() = 0;
 };
 
+// Only indexes the top-level serials of the YAML document at init time, an entry is
+// parsed and converted when it is looked up.
 class YamlGameDatabaseImpl : public IGameDatabase
 {
 public:
 	bool initDatabase(std::istream& stream) override;
+	// `data` must stay valid for the lifetime of the database (e.g. the embedded GameIndex.yaml)
+	bool initDatabase(const char* data, size_t size);
 	GameDatabaseSchema::GameEntry findGame(const std::string serial) override;
 	int numGames() override;
 
 private:
-	std::unordered_map<std::string, GameDatabaseSchema::GameEntry> gameDb;
+	struct EntrySpan
+	{
+		size_t offset; // start of the "serial:" line
+		size_t size;
+	};
+
+	std::string ownedData;
+	const char* gameData = nullptr;
+	std::unordered_map<std::string, EntrySpan> gameIndex;
 	GameDatabaseSchema::GameEntry entryFromYaml(const std::string serial, const YAML::Node& node);
 
 	std::vector<std::string> convertMultiLineStringToVector(const std::string multiLineString);
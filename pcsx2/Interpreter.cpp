@@ -37,6 +37,83 @@ static std::string disOut;
 
 static void intEventTest();
 
+// --------------------------------------------------------------------------------------
+//  Pre-decoded instruction cache
+// --------------------------------------------------------------------------------------
+// Code running out of main ram is decoded once into its handler and cycle count, so
+// execI doesn't have to go through the memory handlers and opcode tables every time.
+// Pages holding decoded code are write protected just like recompiled ones; writes
+// end up in intClear through the page fault handler.  Pages that got written to fall
+// back to manual mode and are only cached again after they've been executed a while.
+
+struct intDecodedOp
+{
+	void (*interpret)();
+	u32 code;
+	u8 cycles;
+};
+
+static const uint intDecodedPageOps = 0x1000 / 4;
+static const uint intManualThreshold = 0x1000;	// uncached runs before a page is protected again
+
+static intDecodedOp* intDecodedPages[Ps2MemSize::MainRam >> 12];
+static u16 intManualCounter[Ps2MemSize::MainRam >> 12];
+
+static void intClearDecodedPage(uint page)
+{
+	if (intDecodedPages[page])
+		memset(intDecodedPages[page], 0, sizeof(intDecodedOp) * intDecodedPageOps);
+}
+
+static void intFreeDecodedPages()
+{
+	for (uint page = 0; page < ArraySize(intDecodedPages); page++)
+		safe_delete_array(intDecodedPages[page]);
+	memzero(intManualCounter);
+}
+
+// Caches the decoded op if its page can be protected.  ramaddr is the physical
+// address of the instruction in main ram.
+static void intCacheDecoded(u32 ramaddr, const OPCODE& opcode)
+{
+	const uint page = ramaddr >> 12;
+
+	// Kernel thread contexts are written all the time (see memory_protect_recompiled_code)
+	if (page == 0x1 || page == 0x81)
+		return;
+
+	switch (mmap_GetRamPageInfo(ramaddr))
+	{
+		case ProtMode_None:
+			mmap_MarkCountedRamPage(ramaddr);
+			break;
+
+		case ProtMode_Write:
+			break;
+
+		case ProtMode_Manual:
+			if (++intManualCounter[page] < intManualThreshold)
+				return;
+			intManualCounter[page] = 0;
+			mmap_MarkCountedRamPage(ramaddr);
+			break;
+
+		default:
+			return;
+	}
+
+	if (!intDecodedPages[page])
+	{
+		intDecodedPages[page] = new intDecodedOp[intDecodedPageOps];
+		intClearDecodedPage(page);
+	}
+
+	intDecodedOp& op = intDecodedPages[page][(ramaddr & 0xfff) >> 2];
+	op.code      = cpuRegs.code;
+	op.cycles    = opcode.cycles;
+	op.interpret = opcode.interpret;
+}
+
 // These macros are used to assemble the repassembler functions
 
 static void debugI()
@@ -72,22 +149,15 @@ void intMemcheck(u32 op, u32 bits, bool store)
 
 	start = standardizeBreakpointAddress(start);
 	u32 end = start + bits/8;
-	
-	auto checks = CBreakPoints::GetMemChecks();
-	for (size_t i = 0; i < checks.size(); i++)
-	{
-		auto& check = checks[i];
 
-		if (check.result == 0)
-			continue;
-		if ((check.cond & MEMCHECK_WRITE) == 0 && store)
-			continue;
-		if ((check.cond & MEMCHECK_READ) == 0 && !store)
-			continue;
+	const IntervalTree<MemCheckResult>& checks = CBreakPoints::GetMemCheckTree(store);
+	bool hit = false;
+	checks.ForEachOverlap(start, end, [&](const IntervalTree<MemCheckResult>::Node&) {
+		hit = true;
+	});
 
-		if (start < check.end && check.start < end)
-			intBreakpoint(true);
-	}
+	if (hit)
+		intBreakpoint(true);
 }
 
 void intCheckMemcheck()
@@ -142,10 +212,37 @@ static void execI()
 	// and it expects the PC counter to be pre-incremented
 	cpuRegs.pc += 4;
 
+	// Only the interpreter gets intClear calls, the recs run delay slots through here too
+	u32 ramaddr = ~0u;
+	if (Cpu == &intCpu)
+	{
+		auto vmv = vtlb_private::vtlbdata.vmap[pc >> vtlb_private::VTLB_PAGE_BITS];
+		if (!vmv.isHandler(pc))
+		{
+			uptr offset = vmv.assumePtr(pc) - (uptr)eeMem->Main;
+			if (offset < Ps2MemSize::MainRam)
+			{
+				ramaddr = offset;
+				const intDecodedOp* decoded = intDecodedPages[ramaddr >> 12];
+				if (decoded && decoded[(ramaddr & 0xfff) >> 2].interpret)
+				{
+					const intDecodedOp& op = decoded[(ramaddr & 0xfff) >> 2];
+					cpuRegs.code = op.code;
+					cpuBlockCycles += op.cycles;
+					op.interpret();
+					return;
+				}
+			}
+		}
+	}
+
 	// interprete instruction
 	cpuRegs.code = memRead32( pc );
 
 	const OPCODE& opcode = GetCurrentInstruction();
+
+	if (ramaddr != ~0u)
+		intCacheDecoded(ramaddr, opcode);
 #if 0
 	static long int runs = 0;
 	//use this to find out what opcodes your game uses. very slow! (rama)
@@ -488,6 +585,9 @@ static void intReset()
 {
 	cpuRegs.branch = 0;
 	branch2 = 0;
+
+	intFreeDecodedPages();
+	mmap_ResetBlockTracking();
 }
 
 static void intEventTest()
@@ -583,9 +683,18 @@ static void intStep()
 
 static void intClear(u32 Addr, u32 Size)
 {
+	// Size is in words.  May run from the page fault handler, so don't free anything.
+	const u32 pages = ((Addr & 0xfff) + Size * 4 + 0xfff) >> 12;
+	for (u32 i = 0; i < pages; i++)
+	{
+		uptr offset = (uptr)PSM((Addr & ~0xfff) + (i << 12)) - (uptr)eeMem->Main;
+		if (offset < Ps2MemSize::MainRam)
+			intClearDecodedPage(offset >> 12);
+	}
 }
 
 static void intShutdown() {
+	intFreeDecodedPages();
 }
 
 static void intThrowException( const BaseR5900Exception& ex )
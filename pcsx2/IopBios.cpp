@@ -490,6 +490,134 @@ namespace sysmem {
 	}
 }
 
+// Native versions of the sysclib memory routines, enabled by the IopHLE
+// speedhack. They only handle plain ranges of IOP main memory and return 0 to
+// let the module code run for anything else (other regions, isolated cache,
+// overlapping copies whose result depends on the copy direction).
+namespace sysclib {
+	static u8* ram_range(u32 addr, u32 size)
+	{
+		addr &= 0x1fffffff;
+		if (addr >= Ps2MemSize::IopRam || size > Ps2MemSize::IopRam - addr)
+			return nullptr;
+		return &iopMem->Main[addr];
+	}
+
+	static bool overlaps(u32 a, u32 b, u32 size)
+	{
+		a &= 0x1fffffff;
+		b &= 0x1fffffff;
+		return a < b + size && b < a + size;
+	}
+
+	// Accounts for the time the module code would have taken
+	static void add_cycles(u32 cycles)
+	{
+		psxRegs.cycle += cycles;
+		iopCycleEE -= cycles * 8;
+	}
+
+	// Drops recompiled blocks over the written range. The module loops take
+	// about a cycle per word when aligned, a few per byte otherwise.
+	static void written(u32 addr, u32 size, bool aligned)
+	{
+		addr &= 0x1fffffff;
+		if (size)
+			psxCpu->Clear(addr & ~3, ((addr & 3) + size + 3) / 4);
+
+		add_cycles(16 + (aligned ? size / 4 : size * 4));
+	}
+
+	static int copy(u32 dst, u32 src, u32 size, bool allowOverlap)
+	{
+		if (psxRegs.CP0.n.Status & 0x10000)
+			return 0;
+
+		u8* pdst = ram_range(dst, size);
+		const u8* psrc = ram_range(src, size);
+		if (!pdst || !psrc || (!allowOverlap && overlaps(dst, src, size)))
+			return 0;
+
+		memmove(pdst, psrc, size);
+		written(dst, size, ((dst | src | size) & 3) == 0);
+		return 1;
+	}
+
+	static int fill(u32 dst, u8 value, u32 size)
+	{
+		if (psxRegs.CP0.n.Status & 0x10000)
+			return 0;
+
+		u8* pdst = ram_range(dst, size);
+		if (!pdst)
+			return 0;
+
+		memset(pdst, value, size);
+		written(dst, size, ((dst | size) & 3) == 0);
+		return 1;
+	}
+
+	int memcpy_HLE()
+	{
+		if (!copy(a0, a1, a2, false))
+			return 0;
+		v0 = a0;
+		pc = ra;
+		return 1;
+	}
+
+	int memmove_HLE()
+	{
+		if (!copy(a0, a1, a2, true))
+			return 0;
+		v0 = a0;
+		pc = ra;
+		return 1;
+	}
+
+	int memset_HLE()
+	{
+		if (!fill(a0, a1, a2))
+			return 0;
+		v0 = a0;
+		pc = ra;
+		return 1;
+	}
+
+	int bcopy_HLE()
+	{
+		if (!copy(a1, a0, a2, false))
+			return 0;
+		pc = ra;
+		return 1;
+	}
+
+	int bzero_HLE()
+	{
+		if (!fill(a0, 0, a1))
+			return 0;
+		pc = ra;
+		return 1;
+	}
+
+	int strlen_HLE()
+	{
+		const u8* str = ram_range(a0, 1);
+		if (!str)
+			return 0;
+
+		const u32 avail = Ps2MemSize::IopRam - (a0 & 0x1fffff);
+		const u8* end = (const u8*)memchr(str, 0, avail);
+		if (!end)
+			return 0;
+
+		v0 = end - str;
+		add_cycles(8 + v0 * 4);
+		pc = ra;
+		return 1;
+	}
+}
+
 namespace loadcore {
 	void RegisterLibraryEntries_DEBUG()
 	{
@@ -582,6 +710,18 @@ irxHLE irxImportHLE(const std::string &libname, u16 index)
 		EXPORT_H(  8, lseek)
 	END_MODULE
 
+	if (EmuConfig.Speedhacks.IopHLE)
+	{
+		MODULE(sysclib)
+			EXPORT_H( 12, memcpy)
+			EXPORT_H( 13, memmove)
+			EXPORT_H( 14, memset)
+			EXPORT_H( 16, bcopy)
+			EXPORT_H( 17, bzero)
+			EXPORT_H( 27, strlen)
+		END_MODULE
+	}
+
 	return 0;
 }
 
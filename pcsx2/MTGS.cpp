@@ -74,6 +74,9 @@ void SysMtgsThread::OnStart()
 	m_VsyncSignalListener = false;
 	m_SignalRingEnable    = false;
 	m_SignalRingPosition  = 0;
+#ifdef __LIBRETRO__
+	m_FrameStepping       = false;
+#endif
 
 	m_CopyDataTally		= 0;
 
@@ -122,6 +125,13 @@ struct RingCmdPacket_Vsync
 
 void SysMtgsThread::PostVsyncStart()
 {
+#ifdef __LIBRETRO__
+	// Frame stepped mode: don't queue this vsync before retro_run() asks for
+	// the frame, so that each call processes exactly one emulated frame.
+	if (m_FrameStepping.load(std::memory_order_acquire))
+		m_sem_FrameStep.WaitNoCancel();
+#endif
+
 	// Optimization note: Typically regset1 isn't needed.  The regs in that area are typically
 	// changed infrequently, usually during video mode changes.  However, on modern systems the
 	// 256-byte copy is only a few dozen cycles -- executed 60 times a second -- so probably
@@ -257,14 +267,15 @@ void SysMtgsThread::ExecuteTaskInThread()
 		busy.Release();
 #endif
 #ifdef __LIBRETRO__
+		// Events queued from other threads post m_sem_event through
+		// Pcsx2App::WakeUpIdle(), so there is no need to poll for them.
 		while (wxTheApp->HasPendingEvents())
 			wxTheApp->ProcessPendingEvents();
 
-		while (!m_sem_event.WaitWithoutYield(wxTimeSpan::Millisecond()))
-		{
-			while (wxTheApp->HasPendingEvents())
-				wxTheApp->ProcessPendingEvents();
-		}
+		m_sem_event.WaitWithoutYield();
+
+		while (wxTheApp->HasPendingEvents())
+			wxTheApp->ProcessPendingEvents();
 #else
 		// Performance note: Both of these perform cancellation tests, but pthread_testcancel
 		// is very optimized (only 1 instruction test in most cases), so no point in trying
@@ -488,8 +499,30 @@ void SysMtgsThread::ExecuteTaskInThread()
 	}
 }
 
+#ifdef __LIBRETRO__
+// Runs the GS side of one frame, up to and including its vsync. In frame
+// stepped mode the EE is also allowed to queue exactly one more vsync. The
+// grant is posted even when stepping gets turned off, the EE may already be
+// waiting for it.
+void SysMtgsThread::StepFrame(bool frameStepping)
+{
+	m_FrameStepping.store(frameStepping, std::memory_order_release);
+	if (!m_sem_FrameStep.Count())
+		m_sem_FrameStep.Post();
+
+	ExecuteTaskInThread();
+}
+#endif
+
 void SysMtgsThread::FinishTaskInThread()
 {
+#ifdef __LIBRETRO__
+	// Let the EE run freely while no frames are being stepped (reset, unload...)
+	m_FrameStepping.store(false, std::memory_order_release);
+	if (!m_sem_FrameStep.Count())
+		m_sem_FrameStep.Post();
+#endif
+
 	if( m_SignalRingEnable.exchange(false) )
 	{
 		//log_cb(RETRO_LOG_WARN, "(MTGS Thread) Dangling RingSignal on empty buffer!  signalpos=0x%06x\n", m_SignalRingPosition.exchange(0) ) );
@@ -19,11 +19,24 @@
 #include "newVif.h"
 #include "Gif_Unit.h"
 
+#include <chrono>
+
 __aligned16 VU_Thread vu1Thread(CpuVU1, VU1);
+__aligned16 VU0_Thread vu0Thread;
 
 #define MTVU_ALWAYS_KICK 0
 #define MTVU_SYNC_MODE 0
 
+// The EE first spins on the ring pointers when it has to wait for MTVU, then
+// sleeps on semaProgress. The spin budget doubles when a wait completes while
+// spinning and halves when it doesn't.
+static const u32 MTVU_SPIN_MIN = 64;
+static const u32 MTVU_SPIN_MAX = 16384;
+
+// Data-only packets (unpacks, memory writes) only wake MTVU once that many
+// words are queued. VU execution and EE waits always wake it.
+static const s32 MTVU_KICK_THRESHOLD = _64kb / sizeof(u32);
+
 // Rounds up a size in bytes for size in u32's
 static __fi u32 size_u32(u32 x) { return (x + 3) >> 2; }
 
@@ -87,6 +100,9 @@ VU_Thread::VU_Thread(BaseVUmicroCPU*& _vuCPU, VURegs& _vuRegs)
 	, vuRegs(_vuRegs)
 {
 	m_name = L"MTVU";
+	m_ee_waiting = false;
+	m_spin_limit = MTVU_SPIN_MIN;
+	ResetWaitStats();
 #ifndef __LIBRETRO__
 	Reset();
 #endif
@@ -105,8 +121,13 @@ void VU_Thread::Reset()
 {
 	ScopedLock lock(mtxBusy);
 
+	ReportWaitStats();
+	ResetWaitStats();
+
 	vuCycleIdx = 0;
 	isBusy = false;
+	m_ee_waiting = false;
+	m_spin_limit = MTVU_SPIN_MIN;
 	m_ato_write_pos = 0;
 	m_write_pos = 0;
 	m_ato_read_pos = 0;
@@ -194,34 +215,83 @@ void VU_Thread::ExecuteRingBuffer()
 
 			CommitReadPos();
 		}
+		lock.Release();
+		// A packet committed while we were leaving the loop above could have seen
+		// isBusy still set and skipped its kick. Check again now that it is cleared
+		// (pairs with the fence in WaitFor).
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_ato_read_pos.load(std::memory_order_relaxed) != GetWritePos())
+			semaEvent.Post();
 	}
 }
 
 
-// Should only be called by ReserveSpace()
-__ri void VU_Thread::WaitOnSize(s32 size)
+// Waits until done() returns true, letting MTVU run meanwhile. Short waits are
+// spun out, as MTVU usually frees the needed space within a packet or two.
+// Longer ones sleep on semaProgress, which MTVU posts after committing a packet
+// while m_ee_waiting is set.
+template <typename Cond>
+__ri void VU_Thread::WaitFor(Cond done)
 {
-	for (;;)
+	if (done())
+		return;
+
+	const auto start = std::chrono::steady_clock::now();
+	KickStartFromEE();
+
+	bool spun = false;
+	for (u32 i = 0; i < m_spin_limit; i++)
 	{
-		s32 readPos = GetReadPos();
-		if (readPos <= m_write_pos)
-			break; // MTVU is reading in back of write_pos
-		// FIXME greg: there is a bug somewhere in the queue pointer
-		// management. It creates a deadlock/corruption in SotC intro (before
-		// the first menu). I added a 4KB safety net which seem to avoid to
-		// trigger the bug.
-		// Note: a wait lock instead of a yield also helps to avoid the bug.
-		if (readPos > m_write_pos + size + _4kb)
-			break; // Enough free front space
-		{          // Let MTVU run to free up buffer space
+		Threading::SpinWait();
+		if (done())
+		{
+			spun = true;
+			break;
+		}
+	}
+
+	if (spun)
+		m_spin_limit = std::min(m_spin_limit * 2, MTVU_SPIN_MAX);
+	else
+	{
+		m_spin_limit = std::max(m_spin_limit / 2, MTVU_SPIN_MIN);
+		m_stats.sleeps++;
+		for (;;)
+		{
+			m_ee_waiting.store(true, std::memory_order_relaxed);
+			// Pairs with the fence in CommitReadPos, so either we see the
+			// progress or MTVU sees the flag.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (done())
+			{
+				// MTVU took the flag already, consume its post
+				if (!m_ee_waiting.exchange(false, std::memory_order_acq_rel))
+					semaProgress.WaitWithoutYield();
+				break;
+			}
 			KickStart();
-			// Locking might trigger a full flush of the ring buffer. Yield
-			// will be more aggressive, and only flush the minimal size.
-			// Performance will be smoother but it will consume extra CPU cycle
-			// on the EE thread (not an issue on 4 cores).
-			std::this_thread::yield();
+			semaProgress.WaitWithoutYield();
+			if (done())
+				break;
 		}
 	}
+
+	m_stats.waits++;
+	m_stats.waitUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Should only be called by ReserveSpace()
+__ri void VU_Thread::WaitOnSize(s32 size)
+{
+	// FIXME greg: there is a bug somewhere in the queue pointer
+	// management. It creates a deadlock/corruption in SotC intro (before
+	// the first menu). I added a 4KB safety net which seem to avoid to
+	// trigger the bug.
+	WaitFor([&]() {
+		s32 readPos = GetReadPos();
+		return readPos <= m_write_pos              // MTVU is reading in back of write_pos
+			|| readPos > m_write_pos + size + _4kb; // Enough free front space
+	});
 }
 
 // Makes sure theres enough room in the ring buffer
@@ -276,6 +346,11 @@ __fi void VU_Thread::CommitWritePos()
 __fi void VU_Thread::CommitReadPos()
 {
 	m_ato_read_pos.store(m_read_pos, std::memory_order_release);
+	// Pairs with the fence in WaitFor(), so either the EE sees the new
+	// position or we see that it is sleeping.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_ee_waiting.load(std::memory_order_relaxed) && m_ee_waiting.exchange(false, std::memory_order_acq_rel))
+		semaProgress.Post();
 }
 
 __fi u32 VU_Thread::Read()
@@ -404,6 +479,27 @@ void VU_Thread::KickStart(bool forceKick)
 		semaEvent.Post();
 }
 
+// Wakes MTVU for data-only packets once enough of them are queued, so it
+// doesn't bounce between sleeping and running for every small transfer.
+__fi void VU_Thread::KickStartBatched()
+{
+	if (MTVU_ALWAYS_KICK || (s32)((m_write_pos - GetReadPos()) & (buffer_size - 1)) >= MTVU_KICK_THRESHOLD)
+		KickStartFromEE();
+}
+
+// KickStart() for the EE's own kicks, which also sample the ring fill for the
+// stats (kicks are far less frequent than packet commits, and m_stats belongs
+// to the EE while MTGS kicks MTVU too).
+__fi void VU_Thread::KickStartFromEE()
+{
+	const u32 fill = GetRingFill();
+	m_stats.kicks++;
+	m_stats.fillSum += fill;
+	m_stats.fillPeak = std::max(m_stats.fillPeak, fill);
+
+	KickStart();
+}
+
 bool VU_Thread::IsDone()
 {
 	return GetReadPos() == GetWritePos();
@@ -414,18 +510,28 @@ void VU_Thread::WaitVU()
 #if 0
 	MTVU_LOG("MTVU - WaitVU!");
 #endif
-	for (;;)
-	{
-		if (IsDone())
-			break;
-#if 0
-		log_cb(RETRO_LOG_DEBUG, "WaitVU()\n");
-		pxAssert(THREAD_VU1);
-#endif
-		KickStart();
-		std::this_thread::yield(); // Give a chance to the MTVU thread to actually start
-		ScopedLock lock(mtxBusy);
-	}
+	WaitFor([this]() { return IsDone(); });
+}
+
+u32 VU_Thread::GetRingFill()
+{
+	return ((m_ato_write_pos.load(std::memory_order_relaxed) - GetReadPos()) & (buffer_size - 1)) * sizeof(u32);
+}
+
+void VU_Thread::ResetWaitStats()
+{
+	memzero(m_stats);
+}
+
+void VU_Thread::ReportWaitStats()
+{
+	if (!m_stats.kicks)
+		return;
+
+	log_cb(RETRO_LOG_DEBUG, "MTVU: %llu kicks, ring fill avg %llu KB peak %u KB, %llu waits (%llu slept) for %llu ms\n",
+		(unsigned long long)m_stats.kicks, (unsigned long long)(m_stats.fillSum / m_stats.kicks / _1kb),
+		m_stats.fillPeak / (u32)_1kb, (unsigned long long)m_stats.waits, (unsigned long long)m_stats.sleeps,
+		(unsigned long long)(m_stats.waitUs / 1000));
 }
 
 void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop)
@@ -441,7 +547,7 @@ void VU_Thread::ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop)
 	Write(vif_itop);
 	CommitWritePos();
 	gifUnit.TransferGSPacketData(GIF_TRANS_MTVU, NULL, 0);
-	KickStart();
+	KickStartFromEE();
 	u32 cycles = std::min(Get_vuCycles(), 3000u);
 	cpuRegs.cycle += cycles * EmuConfig.Speedhacks.EECycleSkip;
 	VU0.cycle += cycles * EmuConfig.Speedhacks.EECycleSkip;
@@ -461,7 +567,7 @@ void VU_Thread::VifUnpack(vifStruct& _vif, VIFregisters& _vifRegs, u8* data, u32
 	Write(size);
 	Write(data, size);
 	CommitWritePos();
-	KickStart();
+	KickStartBatched();
 }
 
 void VU_Thread::WriteMicroMem(u32 vu_micro_addr, void* data, u32 size)
@@ -475,7 +581,7 @@ void VU_Thread::WriteMicroMem(u32 vu_micro_addr, void* data, u32 size)
 	Write(size);
 	Write(data, size);
 	CommitWritePos();
-	KickStart();
+	KickStartBatched();
 }
 
 void VU_Thread::WriteDataMem(u32 vu_data_addr, void* data, u32 size)
@@ -489,7 +595,7 @@ void VU_Thread::WriteDataMem(u32 vu_data_addr, void* data, u32 size)
 	Write(size);
 	Write(data, size);
 	CommitWritePos();
-	KickStart();
+	KickStartBatched();
 }
 
 void VU_Thread::WriteCol(vifStruct& _vif)
@@ -513,3 +619,167 @@ void VU_Thread::WriteRow(vifStruct& _vif)
 	Write(&_vif.MaskRow, sizeof(_vif.MaskRow));
 	CommitWritePos();
 }
+
+// --------------------------------------------------------------------------------------
+//  VU0_Thread
+// --------------------------------------------------------------------------------------
+
+VU0_Thread::VU0_Thread()
+{
+	m_name = L"VU0";
+	m_running = false;
+	m_ee_waiting = false;
+	m_pending = false;
+	m_spin_limit = MTVU_SPIN_MIN;
+	vpuStat = 0;
+	memzero(m_stats);
+}
+
+VU0_Thread::~VU0_Thread()
+{
+	try
+	{
+		pxThread::Cancel();
+	}
+	DESTRUCTOR_CATCHALL
+}
+
+void VU0_Thread::Reset()
+{
+	WaitVU();
+
+	ReportStats();
+	memzero(m_stats);
+	m_spin_limit = MTVU_SPIN_MIN;
+}
+
+void VU0_Thread::ExecuteTaskInThread()
+{
+	PCSX2_PAGEFAULT_PROTECT
+	{
+		for (;;)
+		{
+			semaEvent.WaitWithoutYield();
+			if (!m_running.load(std::memory_order_acquire))
+				continue;
+
+			// Same as vu0Finish(), minus the M-bit: the EE syncs with the end of the program
+			do
+			{
+				CpuVU0->Execute(0x7fffffff);
+			} while (vpuStat & 1);
+
+			m_running.store(false, std::memory_order_release);
+			// Pairs with the fence in WaitVU, so either the EE sees the
+			// program done or we see the flag.
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_ee_waiting.exchange(false, std::memory_order_acq_rel))
+				semaProgress.Post();
+		}
+	}
+	PCSX2_PAGEFAULT_EXCEPT;
+}
+
+void VU0_Thread::ExecuteVU()
+{
+	WaitVU(); // Retire the previous program
+
+	m_pending = true;
+	vpuStat = VU0.VI[REG_VPU_STAT].UL & 0xff;
+	m_stats.programs++;
+	m_running.store(true, std::memory_order_release);
+	semaEvent.Post();
+}
+
+void VU0_Thread::WaitVU()
+{
+	if (!m_pending)
+		return;
+
+	if (!IsDone())
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		// The program may be waiting on MTVU for VU1 registers, and only the
+		// EE kicks MTVU, so make sure it runs whatever is queued
+		if (THREAD_VU1)
+			vu1Thread.KickStart(true);
+
+		bool spun = false;
+		for (u32 i = 0; i < m_spin_limit; i++)
+		{
+			Threading::SpinWait();
+			if (IsDone())
+			{
+				spun = true;
+				break;
+			}
+		}
+
+		if (spun)
+			m_spin_limit = std::min(m_spin_limit * 2, MTVU_SPIN_MAX);
+		else
+		{
+			m_spin_limit = std::max(m_spin_limit / 2, MTVU_SPIN_MIN);
+			m_stats.sleeps++;
+
+			m_ee_waiting.store(true, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (IsDone())
+			{
+				// The VU0 thread took the flag already, consume its post
+				if (!m_ee_waiting.exchange(false, std::memory_order_acq_rel))
+					semaProgress.WaitWithoutYield();
+			}
+			else
+			{
+				semaProgress.WaitWithoutYield();
+			}
+		}
+
+		m_stats.waits++;
+		m_stats.waitUs += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	Retire();
+}
+
+void VU0_Thread::Update()
+{
+	if (!m_pending)
+		Resume();
+	else if (IsDone())
+		Retire();
+}
+
+void VU0_Thread::Resume()
+{
+	if (!m_pending && (VU0.VI[REG_VPU_STAT].UL & 1))
+		ExecuteVU();
+}
+
+// Finishes what the VU0 thread leaves to the EE, as it shares words or
+// queues with state owned by the EE thread.
+void VU0_Thread::Retire()
+{
+	m_pending = false;
+
+	VU0.VI[REG_VPU_STAT].UL = (VU0.VI[REG_VPU_STAT].UL & ~0xff) | vpuStat;
+	vif0Regs.stat.VEW = false;
+
+	if (VU0.flags & VUFLAG_INTCINTERRUPT)
+	{
+		VU0.flags &= ~VUFLAG_INTCINTERRUPT;
+		hwIntcIrq(INTC_VU0);
+	}
+}
+
+void VU0_Thread::ReportStats()
+{
+	if (!m_stats.programs)
+		return;
+
+	log_cb(RETRO_LOG_DEBUG, "VU0 thread: %llu programs, %llu waits (%llu slept) for %llu ms\n",
+		(unsigned long long)m_stats.programs, (unsigned long long)m_stats.waits,
+		(unsigned long long)m_stats.sleeps, (unsigned long long)(m_stats.waitUs / 1000));
+}
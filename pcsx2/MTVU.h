@@ -35,8 +35,11 @@ class VU_Thread : public pxThread {
 	__aligned(64) std::atomic<int> m_ato_write_pos;    // Only modified by EE thread
 	__aligned(64) int  m_read_pos; // temporary read pos (local to the VU thread)
 	int  m_write_pos; // temporary write pos (local to the EE thread)
+	__aligned(64) std::atomic<bool> m_ee_waiting; // EE is sleeping on semaProgress
 	Mutex     mtxBusy;
 	Semaphore semaEvent;
+	Semaphore semaProgress; // Posted by the VU thread on read progress while EE waits
+	u32 m_spin_limit; // Adaptive spin budget of the EE waits (local to the EE thread)
 	BaseVUmicroCPU*& vuCPU;
 	VURegs&          vuRegs;
 
@@ -57,6 +60,17 @@ public:
 	std::atomic<u64> gsLabel; // Used for GS Label command
 	std::atomic<u64> gsSignal; // Used for GS Signal command
 
+	// Ring buffer occupancy and EE wait times, for tuning (EE thread only)
+	struct WaitStats
+	{
+		u64 kicks;      // EE kicks, where the ring fill is sampled
+		u64 fillSum;    // Sum of the ring fill (bytes) sampled at each kick
+		u32 fillPeak;   // Highest sampled ring fill (bytes)
+		u64 waits;      // EE waits that did not complete immediately
+		u64 sleeps;     // Waits that ran out of spins and slept on semaProgress
+		u64 waitUs;     // Total EE time spent waiting
+	};
+
 	VU_Thread(BaseVUmicroCPU*& _vuCPU, VURegs& _vuRegs);
 	virtual ~VU_Thread();
 
@@ -71,6 +85,12 @@ public:
 	// Waits till MTVU is done processing
 	void WaitVU();
 
+	// Bytes queued in the ring buffer and not yet processed by MTVU
+	u32 GetRingFill();
+
+	const WaitStats& GetWaitStats() const { return m_stats; }
+	void ResetWaitStats();
+
 	void Get_GSChanges();
 
 	void ExecuteVU(u32 vu_addr, u32 vif_top, u32 vif_itop);
@@ -93,7 +113,12 @@ protected:
 private:
 	void ExecuteRingBuffer();
 
+	template <typename Cond>
+	void WaitFor(Cond done);
 	void WaitOnSize(s32 size);
+	void KickStartBatched();
+	void KickStartFromEE();
+	void ReportWaitStats();
 	void ReserveSpace(s32 size);
 
 	s32 GetReadPos();
@@ -113,6 +138,71 @@ private:
 	void WriteRegs(VIFregisters* src);
 
 	u32 Get_vuCycles();
+
+	WaitStats m_stats;
 };
 
 extern __aligned16 VU_Thread vu1Thread;
+
+// Runs VU0 micro programs on their own thread while the EE keeps going
+// (THREAD_VU0). The EE only waits for a program when it touches VU0 state:
+// COP2 macro and transfer instructions, LQC2/SQC2, VU0 micro memory writes,
+// VIF0 syncs and resets. A program can't start before the previous one is
+// finished, so a single slot takes the place of VU_Thread's ring buffer.
+class VU0_Thread : public pxThread {
+	// Note: keep atomic on separate cache line to avoid CPU conflict
+	__aligned(64) std::atomic<bool> m_running;    // Program handed over and not finished (cleared by the VU0 thread)
+	__aligned(64) std::atomic<bool> m_ee_waiting; // EE is sleeping on semaProgress
+	bool      m_pending;    // Program started and not retired yet (EE thread only)
+	u32       m_spin_limit; // Adaptive spin budget of the EE waits (EE thread only)
+	Semaphore semaEvent;
+	Semaphore semaProgress; // Posted by the VU0 thread at the end of a program while EE waits
+
+public:
+	// VU0's byte of VPU_STAT as seen by the running program. Its code updates
+	// this copy instead of VPU_STAT, which stays busy till the EE retires the
+	// program, so only the EE thread ever writes VPU_STAT.
+	u32 vpuStat;
+
+	// Programs run and EE waits, for tuning (EE thread only)
+	struct Stats
+	{
+		u64 programs; // Programs run on the VU0 thread
+		u64 waits;    // EE waits that did not complete immediately
+		u64 sleeps;   // Waits that ran out of spins and slept on semaProgress
+		u64 waitUs;   // Total EE time spent waiting
+	};
+
+	VU0_Thread();
+	virtual ~VU0_Thread();
+
+	void Reset();
+
+	// Runs the program set up by vu0ExecMicro() on the VU0 thread
+	void ExecuteVU();
+
+	// Waits till the running program, if any, is done and retires it
+	void WaitVU();
+
+	// Retires a finished program, doesn't wait for a running one
+	void Update();
+
+	// Hands over a program VPU_STAT shows running which wasn't started on
+	// the thread, like one loaded from a savestate
+	void Resume();
+
+	bool IsDone() const { return !m_running.load(std::memory_order_acquire); }
+
+	const Stats& GetStats() const { return m_stats; }
+
+protected:
+	void ExecuteTaskInThread();
+
+private:
+	void Retire();
+	void ReportStats();
+
+	Stats m_stats;
+};
+
+extern __aligned16 VU0_Thread vu0Thread;
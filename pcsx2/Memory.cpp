@@ -47,6 +47,7 @@ BIOS
 #include "SPU2/spu2.h"
 
 #include "Utilities/PageFaultSource.h"
+#include "System/RecTypes.h"
 
 #ifdef ENABLECACHE
 #include "Cache.h"
@@ -973,6 +974,7 @@ static __fi void mmap_ClearCpuBlock( uint offset )
 
 	HostSys::MemProtect( &eeMem->Main[rampage<<12], __pagesize, PageAccess_ReadWrite() );
 	m_PageProtectInfo[rampage].Mode = ProtMode_Manual;
+	RecCacheStats::CountInvalidation(RecInvalidate_WriteFault);
 	Cpu->Clear( m_PageProtectInfo[rampage].ReverseRamMap, 0x400 );
 }
 
@@ -22,6 +22,7 @@
 #include "GameDatabase.h"
 #include "MemoryPatchDatabase.h"
 
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <wx/textfile.h>
@@ -40,6 +41,35 @@ extern void _ApplyPatch(IniPatch* p);
 
 std::vector<IniPatch> Patch;
 
+// The loaded patches of one place, compiled for ApplyLoadedPatches.
+// Runs of plain EE writes are regrouped by vtlb page (keeping their relative order within
+// a page), so a page is translated once per application instead of once per read and write.
+// Anything else (extended codes, IOP patches) is kept in its original position and goes
+// through _ApplyPatch.
+struct PatchProgram
+{
+	struct Write
+	{
+		u32 addr;
+		patch_data_type type;
+		u64 data;
+	};
+
+	struct Op
+	{
+		IniPatch* patch; // NULL for a page of plain writes
+		u32 page;
+		u32 first;
+		u32 count;
+	};
+
+	std::vector<Op> ops;
+	std::vector<Write> writes;
+};
+
+static PatchProgram s_patchProgram[_PPT_END_MARKER];
+static bool s_patchProgramValid = false;
+
 struct PatchTextTable
 {
 	int				code;
@@ -165,6 +195,7 @@ void inifile_process(wxTextFile& f1)
 void ForgetLoadedPatches()
 {
 	Patch.clear();
+	s_patchProgramValid = false;
 }
 
 static int _LoadPatchFiles(const wxDirName& folderName, wxString& fileSpec, const wxString& friendlyName, int& numberFoundPatchFiles)
@@ -378,6 +409,7 @@ namespace PatchFunc
 
 			iPatch.enabled = 1; // omg success!!
 			Patch.push_back(iPatch);
+			s_patchProgramValid = false;
 		}
 
 		return;
@@ -387,12 +419,119 @@ error:
 	void patch(const wxString& cmd, const wxString& param) { patchHelper(cmd, param); }
 } // namespace PatchFunc
 
+using namespace vtlb_private;
+
+static bool IsPlainEEWrite(const IniPatch& p)
+{
+	return p.cpu == CPU_EE && (p.type == BYTE_T || p.type == SHORT_T || p.type == WORD_T || p.type == DOUBLE_T);
+}
+
+static void CompilePatches()
+{
+	for (int place = 0; place < _PPT_END_MARKER; place++)
+	{
+		PatchProgram& prog = s_patchProgram[place];
+
+		prog.ops.clear();
+		prog.writes.clear();
+
+		std::vector<PatchProgram::Write> run;
+
+		auto flush_run = [&]() {
+			std::stable_sort(run.begin(), run.end(), [](const PatchProgram::Write& a, const PatchProgram::Write& b) {
+				return (a.addr >> VTLB_PAGE_BITS) < (b.addr >> VTLB_PAGE_BITS);
+			});
+
+			for (const auto& w : run)
+			{
+				const u32 page = w.addr & ~VTLB_PAGE_MASK;
+
+				if (prog.ops.empty() || prog.ops.back().patch || prog.ops.back().page != page)
+					prog.ops.push_back({NULL, page, (u32)prog.writes.size(), 0});
+
+				prog.ops.back().count++;
+				prog.writes.push_back(w);
+			}
+
+			run.clear();
+		};
+
+		for (auto& i : Patch)
+		{
+			if (i.placetopatch != place || i.enabled == 0)
+				continue;
+
+			if (IsPlainEEWrite(i))
+			{
+				run.push_back({i.addr, i.type, i.data});
+			}
+			else
+			{
+				flush_run();
+				prog.ops.push_back({&i, 0, 0, 0});
+			}
+		}
+
+		flush_run();
+	}
+
+	s_patchProgramValid = true;
+}
+
+template <typename T>
+static __fi void ApplyPatchWrite(u8* page, const PatchProgram::Write& w)
+{
+	T* p = reinterpret_cast<T*>(page + (w.addr & VTLB_PAGE_MASK));
+
+	if (*p != (T)w.data)
+		*p = (T)w.data;
+}
+
+static void ApplyPatchPage(u32 page, const PatchProgram::Write* writes, u32 count)
+{
+	auto vmv = vtlbdata.vmap[page >> VTLB_PAGE_BITS];
+
+	if (vmv.isHandler(page))
+	{
+		// Not direct mapped memory, use the regular handlers
+		for (u32 i = 0; i < count; i++)
+		{
+			IniPatch p = {1, writes[i].type, CPU_EE, 0, writes[i].addr, writes[i].data};
+			_ApplyPatch(&p);
+		}
+
+		return;
+	}
+
+	// Same as the direct path of vtlb_memRead/vtlb_memWrite, minus the lookup
+	u8* ptr = reinterpret_cast<u8*>(vmv.assumePtr(page));
+
+	for (u32 i = 0; i < count; i++)
+	{
+		switch (writes[i].type)
+		{
+			case BYTE_T:   ApplyPatchWrite<u8>(ptr, writes[i]); break;
+			case SHORT_T:  ApplyPatchWrite<u16>(ptr, writes[i]); break;
+			case WORD_T:   ApplyPatchWrite<u32>(ptr, writes[i]); break;
+			case DOUBLE_T: ApplyPatchWrite<u64>(ptr, writes[i]); break;
+			default: break;
+		}
+	}
+}
+
 // This is for applying patches directly to memory
 void ApplyLoadedPatches(patch_place_type place)
 {
-	for (auto& i : Patch)
+	if (!s_patchProgramValid)
+		CompilePatches();
+
+	const PatchProgram& prog = s_patchProgram[place];
+
+	for (const auto& op : prog.ops)
 	{
-		if (i.placetopatch == place)
-			_ApplyPatch(&i);
+		if (op.patch)
+			_ApplyPatch(op.patch);
+		else
+			ApplyPatchPage(op.page, &prog.writes[op.first], op.count);
 	}
 }
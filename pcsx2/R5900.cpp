@@ -36,6 +36,7 @@
 #include "GameDatabase.h"
 
 #include "../DebugTools/Breakpoints.h"
+#include "../DebugTools/GuestProfiler.h"
 #include "R5900OpcodeTables.h"
 
 using namespace R5900;	// for R5900 disasm tools
@@ -375,6 +376,10 @@ __fi void _cpuEventTest_Shared()
 	ScopedBool etest(eeEventTestIsActive);
 	g_nextEventCycle = cpuRegs.cycle + eeWaitCycles;
 
+	// Taken before any exception is raised below, so the pc is still the one that ran.
+	if (GuestProfiler::SampleRequested.load(std::memory_order_relaxed))
+		GuestProfiler::TakeSample();
+
 	// ---- INTC / DMAC (CPU-level Exceptions) -----------------
 	// Done first because exceptions raised during event tests need to be postponed a few
 	// cycles (fixes Grandia II [PAL], which does a spin loop on a vsync and expects to
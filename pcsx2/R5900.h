@@ -400,6 +400,9 @@ extern R5900cpu *Cpu;
 extern R5900cpu intCpu;
 extern R5900cpu recCpu;
 
+// Recompiled block containing the given EE pc (EE thread only, recCpu only).
+extern bool recLookupBlock(u32 pc, u32& startpc, u32& size, u32& intcalls);
+
 enum EE_EventType
 {
 	DMAC_VIF0	= 0,
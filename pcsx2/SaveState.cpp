@@ -147,6 +147,7 @@ static const uint MainMemorySizeInBytes =
 SaveStateBase& SaveStateBase::FreezeMainMemory()
 {
 	vu1Thread.WaitVU(); // Finish VU1 just in-case...
+	vu0Thread.WaitVU();
 	if (IsLoading()) PreLoadPrep();
 	else m_memory->MakeRoomFor( m_idx + MainMemorySizeInBytes );
 
@@ -171,6 +172,7 @@ SaveStateBase& SaveStateBase::FreezeMainMemory()
 SaveStateBase& SaveStateBase::FreezeInternals()
 {
 	vu1Thread.WaitVU(); // Finish VU1 just in-case...
+	vu0Thread.WaitVU();
 	// Print this until the MTVU problem in gifPathFreeze is taken care of (rama)
 #ifndef NDEBUG
 	if (THREAD_VU1)
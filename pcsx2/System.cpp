@@ -76,6 +76,133 @@ void RecompiledCodeReserve::ThrowIfNotOk() const
 		);
 }
 
+// --------------------------------------------------------------------------------------
+//  RecCacheStats  (implementations)
+// --------------------------------------------------------------------------------------
+namespace RecCacheStats
+{
+	struct AtomicCacheInfo
+	{
+		std::atomic<u32> bytesUsed;
+		std::atomic<u32> bytesPeak;
+		std::atomic<u32> capacity;
+		std::atomic<u32> fullFlushes;
+		std::atomic<u64> flushMicros;
+	};
+
+	static const char* const CacheNames[RecCache_Count] = { "EE", "IOP", "VU0", "VU1" };
+	static const char* const ReasonNames[RecInvalidate_Count] = { "write faults", "block checks", "page resets" };
+
+	static AtomicCacheInfo s_caches[RecCache_Count];
+	static std::atomic<u32> s_invalidations[RecInvalidate_Count];
+	static std::atomic<u32> s_clears;
+	static std::atomic<u32> s_pageClears[Ps2MemSize::MainRam >> 12];
+
+	static const uint DumpTopPages = 32;
+
+	void SetUsage(RecCacheType cache, uptr bytesUsed, uptr capacity)
+	{
+		AtomicCacheInfo& info = s_caches[cache];
+		info.bytesUsed.store((u32)bytesUsed, std::memory_order_relaxed);
+		info.capacity.store((u32)capacity, std::memory_order_relaxed);
+		if (bytesUsed > info.bytesPeak.load(std::memory_order_relaxed))
+			info.bytesPeak.store((u32)bytesUsed, std::memory_order_relaxed);
+	}
+
+	void CountFlush(RecCacheType cache, u64 micros)
+	{
+		s_caches[cache].fullFlushes.fetch_add(1, std::memory_order_relaxed);
+		s_caches[cache].flushMicros.fetch_add(micros, std::memory_order_relaxed);
+	}
+
+	void CountInvalidation(RecInvalidateReason reason)
+	{
+		s_invalidations[reason].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void CountClear(u32 start, u32 end)
+	{
+		s_clears.fetch_add(1, std::memory_order_relaxed);
+
+		end = std::min(end, (u32)Ps2MemSize::MainRam);
+		for (u32 page = start >> 12; page < ((end + 0xfff) >> 12); page++)
+			s_pageClears[page].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	CacheInfo GetCache(RecCacheType cache)
+	{
+		const AtomicCacheInfo& info = s_caches[cache];
+		CacheInfo result;
+		result.bytesUsed   = info.bytesUsed.load(std::memory_order_relaxed);
+		result.bytesPeak   = info.bytesPeak.load(std::memory_order_relaxed);
+		result.capacity    = info.capacity.load(std::memory_order_relaxed);
+		result.fullFlushes = info.fullFlushes.load(std::memory_order_relaxed);
+		result.flushMicros = info.flushMicros.load(std::memory_order_relaxed);
+		return result;
+	}
+
+	u32 GetInvalidations(RecInvalidateReason reason)
+	{
+		return s_invalidations[reason].load(std::memory_order_relaxed);
+	}
+
+	u32 GetClears()
+	{
+		return s_clears.load(std::memory_order_relaxed);
+	}
+
+	void Reset()
+	{
+		// Occupancy is left alone, it describes the caches as they are now.
+		for (AtomicCacheInfo& info : s_caches)
+		{
+			info.bytesPeak.store(info.bytesUsed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			info.fullFlushes.store(0, std::memory_order_relaxed);
+			info.flushMicros.store(0, std::memory_order_relaxed);
+		}
+		for (std::atomic<u32>& count : s_invalidations)
+			count.store(0, std::memory_order_relaxed);
+		for (std::atomic<u32>& count : s_pageClears)
+			count.store(0, std::memory_order_relaxed);
+		s_clears.store(0, std::memory_order_relaxed);
+	}
+
+	bool Dump(const char* filename)
+	{
+		FILE* fp = fopen(filename, "w");
+		if (!fp) return false;
+
+		fprintf(fp, "-- Recompiler caches --\n%-4s %12s %12s %12s %8s %12s\n", "", "used", "peak", "capacity", "flushes", "flush usec");
+		for (int i = 0; i < RecCache_Count; i++)
+		{
+			CacheInfo info = GetCache((RecCacheType)i);
+			fprintf(fp, "%-4s %12u %12u %12u %8u %12llu\n", CacheNames[i], info.bytesUsed, info.bytesPeak,
+				info.capacity, info.fullFlushes, (unsigned long long)info.flushMicros);
+		}
+
+		fprintf(fp, "\n-- EE block invalidation --\n%-14s %10u\n", "clears", GetClears());
+		for (int i = 0; i < RecInvalidate_Count; i++)
+			fprintf(fp, "%-14s %10u\n", ReasonNames[i], GetInvalidations((RecInvalidateReason)i));
+
+		std::vector<std::pair<u32, u32>> pages;
+		for (u32 page = 0; page < ArraySize(s_pageClears); page++)
+		{
+			u32 count = s_pageClears[page].load(std::memory_order_relaxed);
+			if (count) pages.push_back(std::make_pair(count, page));
+		}
+		std::sort(pages.begin(), pages.end(), [](const std::pair<u32, u32>& a, const std::pair<u32, u32>& b) {
+			return a.first > b.first;
+		});
+
+		fprintf(fp, "\n-- Most invalidated EE pages (%u of %u) --\n", std::min((uint)pages.size(), DumpTopPages), (uint)pages.size());
+		for (size_t i = 0; i < pages.size() && i < DumpTopPages; i++)
+			fprintf(fp, "0x%08x %10u\n", pages[i].second << 12, pages[i].first);
+
+		fclose(fp);
+		return true;
+	}
+}
+
 void SysOutOfMemory_EmergencyResponse(uptr blocksize)
 {
 	// An out of memory error occurred.  All we can try to do in response is reset the various
@@ -334,6 +461,7 @@ void SysMainMemory::DecommitAll()
 	// The EE thread must be stopped here command mustn't be send
 	// to the ring. Let's call it an extra safety valve :)
 	vu1Thread.Reset();
+	vu0Thread.Reset();
 
 	m_ee.Decommit();
 	m_iop.Decommit();
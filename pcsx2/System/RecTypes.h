@@ -15,6 +15,9 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+
 #include "Utilities/PageFaultSource.h"
 
 // --------------------------------------------------------------------------------------
@@ -46,3 +49,77 @@ public:
 protected:
 	void ResetProcessReserves() const;
 };
+
+// --------------------------------------------------------------------------------------
+//  RecCacheStats
+// --------------------------------------------------------------------------------------
+// Occupancy, flush and invalidation counters for the recompiler caches.  They are updated
+// by whichever thread runs the recompiler (the MTVU thread for VU1, the page fault handler
+// for write faults) and read by the frontend, so everything is a relaxed atomic.
+//
+enum RecCacheType
+{
+	RecCache_EE = 0,
+	RecCache_IOP,
+	RecCache_VU0,
+	RecCache_VU1,
+	RecCache_Count
+};
+
+enum RecInvalidateReason
+{
+	RecInvalidate_WriteFault = 0,	// Write to a page under vtlb write protection
+	RecInvalidate_BlockCheck,		// Manually protected block failed its integrity check
+	RecInvalidate_PageReset,		// Manually protected page moved back to write protection
+	RecInvalidate_Count
+};
+
+namespace RecCacheStats
+{
+	struct CacheInfo
+	{
+		u32 bytesUsed;
+		u32 bytesPeak;
+		u32 capacity;
+		u32 fullFlushes;	// Resets forced by the cache filling up
+		u64 flushMicros;	// Time spent in those resets
+	};
+
+	void SetUsage(RecCacheType cache, uptr bytesUsed, uptr capacity);
+	void CountFlush(RecCacheType cache, u64 micros);
+
+	void CountInvalidation(RecInvalidateReason reason);
+	// EE main ram range [start, end) whose recompiled blocks were cleared.
+	void CountClear(u32 start, u32 end);
+
+	CacheInfo GetCache(RecCacheType cache);
+	u32 GetInvalidations(RecInvalidateReason reason);
+	u32 GetClears();
+
+	void Reset();
+
+	// Writes every counter and the most invalidated EE pages.  Returns false if the file
+	// couldn't be created.
+	bool Dump(const char* filename);
+
+	// Times a full cache reset, counting it only when active.
+	class ScopedFlush
+	{
+		RecCacheType m_cache;
+		bool m_active;
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		ScopedFlush(RecCacheType cache, bool active = true)
+			: m_cache(cache), m_active(active), m_start(std::chrono::steady_clock::now())
+		{
+		}
+
+		~ScopedFlush()
+		{
+			if (!m_active) return;
+			auto elapsed = std::chrono::steady_clock::now() - m_start;
+			CountFlush(m_cache, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+		}
+	};
+}
@@ -154,6 +154,7 @@ struct __aligned16 VURegs {
 	u32 macflag;
 	u32 statusflag;
 	u32 clipflag;
+	bool skipflags;	// interpreter only: current upper op's MAC/status results are never read
 
 	s32 nextBlockCycles;
 
@@ -175,6 +176,7 @@ struct __aligned16 VURegs {
 	{
 		Mem = NULL;
 		Micro = NULL;
+		skipflags = false;
 	}
 
 	bool IsVU1() const;
@@ -30,6 +30,7 @@
 #include "R5900OpcodeTables.h"
 #include "VUmicro.h"
 #include "Vif_Dma.h"
+#include "MTVU.h"
 
 #define _Ft_ _Rt_
 #define _Fs_ _Rd_
@@ -56,6 +57,19 @@ void COP2_Unknown()
 
 __fi void _vu0run(bool breakOnMbit, bool addCycles) {
 
+	if (THREAD_VU0) {
+		// The program runs to its end on the VU0 thread, M-bit syncs wait for all of it.
+		// The EE is stalled until the cycle the program would have ended at.
+		vu0Thread.Resume();
+		vu0Thread.WaitVU();
+		if (addCycles) {
+			if ((s32)(VU0.cycle - cpuRegs.cycle) > 0)
+				cpuRegs.cycle = VU0.cycle;
+			VU0.cycle = cpuRegs.cycle;
+		}
+		return;
+	}
+
 	if (!(VU0.VI[REG_VPU_STAT].UL & 1)) return;
 
 	//VU0 is ahead of the EE and M-Bit is already encountered, so no need to wait for it, just catch up the EE
@@ -84,6 +98,7 @@ __fi void _vu0run(bool breakOnMbit, bool addCycles) {
 void _vu0WaitMicro()   { _vu0run(1, 1); } // Runs VU0 Micro Until E-bit or M-Bit End
 void _vu0FinishMicro() { _vu0run(0, 1); } // Runs VU0 Micro Until E-Bit End
 void vu0Finish()	   { _vu0run(0, 0); } // Runs VU0 Micro Until E-Bit End (doesn't stall EE)
+void vu0WaitThread()   { vu0Thread.WaitVU(); } // Waits for the VU0 thread before the EE touches VU0 state (doesn't stall EE)
 
 namespace R5900 {
 namespace Interpreter{
@@ -21,6 +21,7 @@
 #include "PrecompiledHeader.h"
 #include "Common.h"
 #include "VUmicro.h"
+#include "MTVU.h"
 
 #include <cmath>
 
@@ -29,6 +30,8 @@ using namespace R5900;
 // This is called by the COP2 as per the CTC instruction
 void vu0ResetRegs()
 {
+	vu0Thread.WaitVU();
+
 	VU0.VI[REG_VPU_STAT].UL &= ~0xff; // stop vu0
 	VU0.VI[REG_FBRST].UL &= ~0xff; // stop vu0
 	vif0Regs.stat.VEW = false;
@@ -53,5 +56,8 @@ void __fastcall vu0ExecMicro(u32 addr) {
 
 	CpuVU0->SetStartPC(VU0.VI[REG_TPC].UL << 3);
 	_vuExecMicroDebug(VU0);
-	CpuVU0->ExecuteBlock(1);
+	if (THREAD_VU0)
+		vu0Thread.ExecuteVU();
+	else
+		CpuVU0->ExecuteBlock(1);
 }
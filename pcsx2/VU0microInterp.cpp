@@ -26,7 +26,9 @@ extern void _vuFlushAll(VURegs* VU);
 static void _vu0ExecUpper(VURegs* VU, u32 *ptr) {
 	VU->code = ptr[1];
 	IdebugUPPER(VU0);
+	VU->skipflags = !vuUpperFlagsLive(*VU, VU->VI[REG_TPC].UL - 8);
 	VU0_UPPER_OPCODE[VU->code & 0x3f]();
+	VU->skipflags = false;
 }
 
 static void _vu0ExecLower(VURegs* VU, u32 *ptr) {
@@ -25,7 +25,9 @@ extern void _vuFlushAll(VURegs* VU);
 void _vu1ExecUpper(VURegs* VU, u32 *ptr) {
 	VU->code = ptr[1];
 	//IdebugUPPER(VU1);
+	VU->skipflags = !vuUpperFlagsLive(*VU, VU->VI[REG_TPC].UL - 8);
 	VU1_UPPER_OPCODE[VU->code & 0x3f]();
+	VU->skipflags = false;
 }
 
 void _vu1ExecLower(VURegs* VU, u32 *ptr) {
@@ -203,6 +205,7 @@ InterpVU1::InterpVU1()
 
 void InterpVU1::Reset() {
 	vu1Thread.WaitVU();
+	vuClearFlagsLive(VU1);
 }
 
 void InterpVU1::Shutdown() noexcept {
@@ -47,6 +47,15 @@ static __ri u32 VU_MAC_UPDATE( int shift, VURegs * VU, float f )
 	int exp = (v >> 23) & 0xff;
 	u32 s = v & 0x80000000;
 
+	if (VU->skipflags)
+	{
+		// Nobody reads this op's flags, only the clamped result matters
+		if (f == 0) return v;
+		if (exp == 0) return s;
+		if (exp == 255) return s|0x7f7fffff;
+		return v;
+	}
+
 	if (s)
 		VU->macflag |= 0x0010<<shift;
 	else
@@ -94,25 +103,30 @@ __fi u32 VU_MACw_UPDATE(VURegs * VU, float w)
 
 __fi void VU_MACx_CLEAR(VURegs * VU)
 {
+	if (VU->skipflags) return;
 	VU->macflag&= ~(0x1111<<3);
 }
 
 __fi void VU_MACy_CLEAR(VURegs * VU)
 {
+	if (VU->skipflags) return;
 	VU->macflag&= ~(0x1111<<2);
 }
 
 __fi void VU_MACz_CLEAR(VURegs * VU)
 {
+	if (VU->skipflags) return;
 	VU->macflag&= ~(0x1111<<1);
 }
 
 __fi void VU_MACw_CLEAR(VURegs * VU)
 {
+	if (VU->skipflags) return;
 	VU->macflag&= ~(0x1111<<0);
 }
 
 __ri void VU_STAT_UPDATE(VURegs * VU) {
+	if (VU->skipflags) return;
 	int newflag = 0 ;
 	if (VU->macflag & 0x000F) newflag = 0x1;
 	if (VU->macflag & 0x00F0) newflag |= 0x2;
@@ -120,3 +134,128 @@ __ri void VU_STAT_UPDATE(VURegs * VU) {
 	if (VU->macflag & 0xF000) newflag |= 0x8;
 	VU->statusflag = (VU->statusflag&0xc30)|newflag|((VU->statusflag&0xf)<<6);
 }
+
+/*****************************************/
+/*          FLAG LIVENESS                */
+/*****************************************/
+
+// Most FMAC ops compute MAC/status flags that the next FMAC op overwrites before
+// anything looks at them.  Straight-line runs of micro code are scanned once and
+// every flag writer nobody can observe is marked dead, so the interpreters only
+// compute its result.  A reader (FSxxx/FMxxx, DIV/SQRT/RSQRT) can see any writer
+// still in flight in the FMAC pipe plus the last one committed before those, and
+// the end of a run (branch, E/D/T/M-bit) exposes the same to whatever runs next.
+// A writer's status bits 6-9 come from the previous writer, so that one is kept too.
+// Clip flags are left alone, every CLIP shifts the older ones along.
+
+static const int FlagsLiveWindow = 8; // cycles a writer can stay hidden in the FMAC pipe
+
+enum FlagsLiveState
+{
+	FLAGS_UNKNOWN = 0,
+	FLAGS_DEAD,
+	FLAGS_LIVE
+};
+
+static u8 vuFlagsLive[2][VU1_PROGSIZE / 8];
+
+static bool vuUpperWritesFlags(u32 code)
+{
+	u32 op = code & 0x3f;
+	if (op < 0x3c)
+	{
+		switch (op)
+		{
+			case 0x10: case 0x11: case 0x12: case 0x13: // MAX
+			case 0x14: case 0x15: case 0x16: case 0x17: // MINI
+			case 0x1d: case 0x1f: case 0x2b: case 0x2f: // MAXi/MINIi/MAX/MINI
+				return false;
+		}
+		return op < 0x30;
+	}
+
+	u32 fd = (code >> 6) & 0x1f;
+	if (fd >= 12 || fd == 4 || fd == 5) return false;       // ITOF/FTOI
+	if (op == 0x3d && fd == 7) return false;                 // ABS
+	if (op == 0x3f && (fd == 7 || fd >= 10)) return false;   // CLIP/NOP
+	return true;
+}
+
+static bool vuLowerReadsFlags(u32 code)
+{
+	u32 op = code >> 25;
+	if (op >= 0x14 && op <= 0x1b)
+		return op != 0x19; // FSEQ..FSOR, FMEQ/FMAND/FMOR
+	if (op == 0x40 && (code & 0x3f) >= 0x3c && (code & 0x3f) <= 0x3e)
+		return ((code >> 6) & 0x1f) == 0x0e; // DIV/SQRT/RSQRT
+	return false;
+}
+
+static void vuAnalyzeFlags(VURegs& VU, u8* live, u32 start, u32 mask)
+{
+	u16 writers[VU1_PROGSIZE / 8];
+	u8  needed[VU1_PROGSIZE / 8];
+	int nw  = 0;
+	int end = mask;
+
+	// Keeps every writer a reader at 'slot' might see
+	auto markReader = [&](int slot) {
+		for (int w = nw - 1; w >= 0; w--)
+		{
+			needed[w] = 1;
+			if (writers[w] < slot - FlagsLiveWindow)
+			{
+				if (w > 0) needed[w - 1] = 1;
+				break;
+			}
+		}
+	};
+
+	for (int i = 0; i <= end; i++)
+	{
+		const u32* ptr = (u32*)&VU.Micro[((start + i) & mask) * 8];
+		const u32 upper = ptr[1];
+
+		if (vuUpperWritesFlags(upper))
+		{
+			writers[nw] = i;
+			needed[nw++] = 0;
+		}
+
+		if (upper & 0x40000000) // E-bit, the delay slot still runs
+			end = std::min(end, i + 1);
+		if (upper & 0x38000000) // M/D/T-bit
+			end = i;
+
+		if (!(upper & 0x80000000))
+		{
+			const u32 lower = ptr[0];
+			if (vuLowerReadsFlags(lower))
+				markReader(i);
+			if ((lower >> 25) >= 0x20 && (lower >> 25) <= 0x2f) // branches
+				end = std::min(end, i + 1);
+		}
+	}
+	markReader(end);
+
+	for (int i = 0; i <= end; i++)
+		live[(start + i) & mask] = FLAGS_LIVE;
+	for (int w = 0; w < nw; w++)
+		live[(start + writers[w]) & mask] = needed[w] ? FLAGS_LIVE : FLAGS_DEAD;
+}
+
+bool vuUpperFlagsLive(VURegs& VU, u32 pc)
+{
+	u8* live = vuFlagsLive[VU.IsVU1()];
+	u32 mask = (VU.IsVU1() ? VU1_PROGSIZE : VU0_PROGSIZE) / 8 - 1;
+	u32 slot = (pc >> 3) & mask;
+
+	if (live[slot] == FLAGS_UNKNOWN)
+		vuAnalyzeFlags(VU, live, slot, mask);
+	return live[slot] == FLAGS_LIVE;
+}
+
+void vuClearFlagsLive(VURegs& VU)
+{
+	memzero(vuFlagsLive[VU.IsVU1()]);
+}
@@ -25,3 +25,8 @@ extern void VU_MACy_CLEAR(VURegs * VU);
 extern void VU_MACz_CLEAR(VURegs * VU);
 extern void VU_MACw_CLEAR(VURegs * VU);
 extern void VU_STAT_UPDATE(VURegs * VU);
+
+// Upper MAC/status flag liveness for the micro interpreters.  Flag results that no
+// later instruction can observe are skipped (see VUflags.cpp).
+extern bool vuUpperFlagsLive(VURegs& VU, u32 pc);
+extern void vuClearFlagsLive(VURegs& VU);
@@ -29,6 +29,12 @@ void BaseVUmicroCPU::ExecuteBlock(bool startUp) {
 		vu1Thread.Get_GSChanges();
 	}
 
+	if (!m_Idx && THREAD_VU0)
+	{
+		vu0Thread.Update(); // Runs on the VU0 thread, only pick up finished programs
+		return;
+	}
+
 	if (!(stat & test)) return;
 
 	if (startUp && s) {  // Start Executing a microprogram
@@ -52,6 +58,12 @@ void BaseVUmicroCPU::ExecuteBlockJIT(BaseVUmicroCPU* cpu) {
 	const u32& stat	= VU0.VI[REG_VPU_STAT].UL;
 	const int  test = 1;
 
+	if (THREAD_VU0) {
+		vu0Thread.Resume();
+		vu0Thread.WaitVU();
+		return;
+	}
+
 	if (stat & test) {		// VU is running
 		s32 delta = (s32)(u32)(cpuRegs.cycle - VU0.cycle);
 		s32 nextblockcycles = VU0.nextBlockCycles;
@@ -170,12 +170,12 @@ public:
 
 	void Reserve() { }
 	void Shutdown() noexcept { }
-	void Reset() { }
+	void Reset() { vuClearFlagsLive(VU0); }
 
 	void Step();
 	void SetStartPC(u32 startPC);
 	void Execute(u32 cycles);
-	void Clear(u32 addr, u32 size) {}
+	void Clear(u32 addr, u32 size) { vuClearFlagsLive(VU0); }
 
 	uint GetCacheReserve() const { return 0; }
 	void SetCacheReserve( uint reserveInMegs ) const {}
@@ -197,7 +197,7 @@ public:
 	void SetStartPC(u32 startPC);
 	void Step();
 	void Execute(u32 cycles);
-	void Clear(u32 addr, u32 size) {}
+	void Clear(u32 addr, u32 size) { vuClearFlagsLive(VU1); }
 	void ResumeXGkick() {}
 
 	uint GetCacheReserve() const { return 0; }
@@ -261,6 +261,7 @@ extern void __fastcall vu0ExecMicro(u32 addr);
 extern void vu0Exec(VURegs* VU);
 extern void _vu0FinishMicro();
 extern void vu0Finish();
+extern void vu0WaitThread();
 
 // VU1
 extern void vu1Finish(bool add_cycles);
@@ -188,6 +188,9 @@ public:
 	//  Overrides of wxApp virtuals:
 	// --------------------------------------------------------------------------
 	wxAppTraits* CreateTraits();
+#ifdef __LIBRETRO__
+	void WakeUpIdle();
+#endif
 	bool OnInit();
 	int  OnExit();
 	void CleanUp();
@@ -21,10 +21,8 @@
 
 AppGameDatabase& AppGameDatabase::Load()
 {
-	std::string game_index(reinterpret_cast<const char*>(&GameIndex_yaml), GameIndex_yaml_len);
-	std::istringstream stream(game_index);
-
-	if (!this->initDatabase(stream))
+	// Indexed in place, entries are only parsed when looked up
+	if (!this->initDatabase(reinterpret_cast<const char*>(&GameIndex_yaml), GameIndex_yaml_len))
 	{
 		log_cb(RETRO_LOG_ERROR, "[GameDB] Database could not be loaded successfully\n");
 		return *this;
@@ -145,6 +145,7 @@ Pcsx2App::~Pcsx2App()
 {
 	try {
 		vu1Thread.Cancel();
+		vu0Thread.Cancel();
 	}
 	DESTRUCTOR_CATCHALL
 }
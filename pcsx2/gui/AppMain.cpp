@@ -78,6 +78,15 @@ wxAppTraits* Pcsx2App::CreateTraits()
 	return new Pcsx2AppTraits;
 }
 
+#ifdef __LIBRETRO__
+// There is no running wx event loop in the libretro core, pending events are
+// processed by the MTGS loop in retro_run(). Wake that up instead.
+void Pcsx2App::WakeUpIdle()
+{
+	mtgsThread.WakeUp();
+}
+#endif
+
 // ----------------------------------------------------------------------------
 //         Pcsx2App Event Handlers
 // ----------------------------------------------------------------------------
@@ -14,7 +14,6 @@
  */
 
 #include "PrecompiledHeader.h"
-#include "Utilities/SafeArray.inl"
 
 #include "MemoryCardFile.h"
 
@@ -25,12 +24,25 @@
 
 #include <wx/ffile.h>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include  "options_tools.h"
 
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
 static const int MCD_SIZE = 1024 * 8 * 16; // Legacy PSX card default size
 
 static const int MC2_MBSIZE = 1024 * 528 * 2; // Size of a single megabyte of card data
 
+static const int MCD_DIRTY_CHUNK = 528 * 16; // Write-back granularity, one erase block (with ECC)
+
+static const int MCD_FLUSH_DELAY_MS = 250; // Lets a save in progress finish before it is written out
+
 // ECC code ported from mymc
 // https://sourceforge.net/p/mymc-opl/code/ci/master/tree/ps2mc_ecc.py
 // Public domain license
@@ -142,24 +154,31 @@ static bool ConvertRAWtoNoECC(wxString file_in, wxString file_out)
 // --------------------------------------------------------------------------------------
 //  FileMemoryCard
 // --------------------------------------------------------------------------------------
-// Provides thread-safe direct file IO mapping.
+// Keeps the whole card image of every slot in RAM, so reads and writes coming from the
+// SIO never touch the disk.  Modified erase blocks are marked dirty and written back by
+// a background thread; Close() flushes whatever is left and syncs the files.
 //
 class FileMemoryCard
 {
 protected:
 	wxFFile m_file[8];
+	std::vector<u8> m_image[8];
+	std::vector<u8> m_dirty[8]; // one flag per MCD_DIRTY_CHUNK of the file
+	u32 m_offset[8];            // size of the header in front of the card data, see GetHeaderSize()
 	u8 m_effeffs[528 * 16];
-	SafeArray<u8> m_currentdata;
 	u64 m_chksum[8];
 	bool m_ispsx[8];
 	u32 m_chkaddr;
 
+	std::mutex m_lock;
+	std::condition_variable m_cv;
+	std::thread m_writer;
+	bool m_writer_exit;
+	bool m_pending;
+
 public:
 	FileMemoryCard();
-	virtual ~FileMemoryCard() = default;
-
-	void Lock();
-	void Unlock();
+	virtual ~FileMemoryCard() { Close(); }
 
 	void Open();
 	void Close();
@@ -173,8 +192,14 @@ public:
 	u64 GetCRC(uint slot);
 
 protected:
-	bool Seek(wxFFile& f, u32 adr);
+	static u32 GetHeaderSize(size_t size);
 	bool Create(const wxString& mcdFile, uint sizeInMB);
+	bool Load(uint slot);
+
+	void MarkDirty(uint slot, size_t begin, size_t end);
+	void XorPSXChecksum(uint slot, size_t begin, size_t end);
+	void Flush(std::unique_lock<std::mutex>& lock);
+	void WriterThread();
 
 	wxString GetDisabledMessage(uint slot) const
 	{
@@ -246,7 +271,12 @@ wxString FileMcd_GetDefaultName(uint slot)
 FileMemoryCard::FileMemoryCard()
 {
 	memset8<0xff>(m_effeffs);
+	memzero(m_offset);
+	memzero(m_chksum);
+	memzero(m_ispsx);
 	m_chkaddr = 0;
+	m_writer_exit = false;
+	m_pending = false;
 }
 
 void FileMemoryCard::Open()
@@ -329,29 +359,98 @@ void FileMemoryCard::Open()
 					wxsFormat("Access denied to memory card: \n\n%s\n\n %s\n", str.c_str(), GetDisabledMessage(slot).c_str()).c_str()
 			      );
 		}
-		else // Load checksum
+		else if (!Load(slot))
 		{
-			m_ispsx[slot] = m_file[slot].Length() == 0x20000;
-			m_chkaddr = 0x210;
-
-			if (!m_ispsx[slot] && !!m_file[slot].Seek(m_chkaddr))
-				m_file[slot].Read(&m_chksum[slot], 8);
+			log_cb(RETRO_LOG_ERROR, "(FileMcd) Could not read memory card: %s\n", WX_STR(str));
+			m_file[slot].Close();
 		}
 	}
+
+	if (!m_writer.joinable())
+	{
+		m_writer_exit = false;
+		m_pending = false;
+		m_writer = std::thread(&FileMemoryCard::WriterThread, this);
+	}
+}
+
+// Reads the whole card into m_image and sets up the checksum.
+bool FileMemoryCard::Load(uint slot)
+{
+	wxFFile& mcfp(m_file[slot]);
+
+	const size_t size = mcfp.Length();
+
+	m_image[slot].resize(size);
+	m_dirty[slot].assign((size + MCD_DIRTY_CHUNK - 1) / MCD_DIRTY_CHUNK, 0);
+	m_offset[slot] = GetHeaderSize(size);
+
+	if (!mcfp.Seek(0) || mcfp.Read(m_image[slot].data(), size) != size)
+	{
+		m_image[slot].clear();
+		m_dirty[slot].clear();
+		return false;
+	}
+
+	m_ispsx[slot] = size == 0x20000;
+	m_chkaddr = 0x210;
+	m_chksum[slot] = 0;
+
+	if (m_ispsx[slot])
+	{
+		// PSX cards have no stored checksum, it is the xor of the image (kept up to date by Save/EraseBlock)
+		XorPSXChecksum(slot, 0, size);
+	}
+	else if (m_chkaddr + 8 <= size)
+	{
+		memcpy(&m_chksum[slot], &m_image[slot][m_chkaddr], 8);
+	}
+
+	return true;
 }
 
 void FileMemoryCard::Close()
 {
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	if (m_writer.joinable())
+	{
+		m_writer_exit = true;
+		m_cv.notify_one();
+
+		lock.unlock();
+		m_writer.join();
+		lock.lock();
+	}
+
+	for (uint slot = 0; slot < 8; ++slot)
+	{
+		// Store checksum
+		if (m_file[slot].IsOpened() && !m_ispsx[slot] && m_chkaddr + 8 <= m_image[slot].size())
+		{
+			memcpy(&m_image[slot][m_chkaddr], &m_chksum[slot], 8);
+			MarkDirty(slot, m_chkaddr, m_chkaddr + 8);
+		}
+	}
+
+	Flush(lock);
+
 	for (int slot = 0; slot < 8; ++slot)
 	{
 		if (m_file[slot].IsOpened())
 		{
-			// Store checksum
-			if (!m_ispsx[slot] && !!m_file[slot].Seek(m_chkaddr))
-				m_file[slot].Write(&m_chksum[slot], 8);
-
+			m_file[slot].Flush();
+#ifdef _WIN32
+			_commit(_fileno(m_file[slot].fp()));
+#else
+			fsync(fileno(m_file[slot].fp()));
+#endif
 			m_file[slot].Close();
 
+			m_image[slot].clear();
+			m_image[slot].shrink_to_fit();
+			m_dirty[slot].clear();
+
 			if (m_file[slot].GetName().EndsWith(".binx"))
 			{
 				wxString name = m_file[slot].GetName();
@@ -363,27 +462,105 @@ void FileMemoryCard::Close()
 	}
 }
 
-// Returns FALSE if the seek failed (is outside the bounds of the file).
-bool FileMemoryCard::Seek(wxFFile& f, u32 adr)
+u32 FileMemoryCard::GetHeaderSize(size_t size)
 {
-	const u32 size = f.Length();
-
 	// If anyone knows why this filesize logic is here (it appears to be related to legacy PSX
 	// cards, perhaps hacked support for some special emulator-specific memcard formats that
 	// had header info?), then please replace this comment with something useful.  Thanks!  -- air
 
-	u32 offset = 0;
-
 	if (size == MCD_SIZE + 64)
-		offset = 64;
+		return 64;
 	else if (size == MCD_SIZE + 3904)
-		offset = 3904;
-	else
+		return 3904;
+
+	return 0;
+}
+
+// [begin, end) are file offsets.  Must be called with m_lock held.
+void FileMemoryCard::MarkDirty(uint slot, size_t begin, size_t end)
+{
+	for (size_t i = begin / MCD_DIRTY_CHUNK; i <= (end - 1) / MCD_DIRTY_CHUNK; i++)
+		m_dirty[slot][i] = 1;
+
+	m_pending = true;
+}
+
+// Adds (or removes, it is an xor) the 64-bit words covering [begin, end) to the PSX card checksum.
+// Only whole 528 * 64 byte chunks of the file are part of it, as they were when the file was reread.
+void FileMemoryCard::XorPSXChecksum(uint slot, size_t begin, size_t end)
+{
+	const size_t chunk = 528 * 8 * sizeof(u64);
+	const size_t limit = m_image[slot].size() / chunk * chunk;
+
+	begin &= ~(size_t)7;
+	end = std::min((end + 7) & ~(size_t)7, limit);
+
+	for (size_t i = begin; i < end; i += 8)
 	{
-		// perform sanity checks here?
+		u64 v;
+		memcpy(&v, &m_image[slot][i], 8);
+		m_chksum[slot] ^= v;
+	}
+}
+
+// Writes every dirty run of chunks to its file.  The data is copied with the lock held and
+// written without it, a chunk modified meanwhile is simply flagged dirty again.
+void FileMemoryCard::Flush(std::unique_lock<std::mutex>& lock)
+{
+	std::vector<u8> buffer;
+
+	for (uint slot = 0; slot < 8; ++slot)
+	{
+		std::vector<u8>& dirty = m_dirty[slot];
+
+		for (size_t i = 0; i < dirty.size(); i++)
+		{
+			if (!dirty[i] || !m_file[slot].IsOpened())
+				continue;
+
+			size_t j = i;
+
+			while (j < dirty.size() && dirty[j])
+				dirty[j++] = 0;
+
+			const size_t begin = i * MCD_DIRTY_CHUNK;
+			const size_t end = std::min(j * MCD_DIRTY_CHUNK, m_image[slot].size());
+
+			buffer.assign(m_image[slot].begin() + begin, m_image[slot].begin() + end);
+
+			lock.unlock();
+
+			const bool ok = m_file[slot].Seek(begin) && m_file[slot].Write(buffer.data(), buffer.size()) == buffer.size();
+
+			lock.lock();
+
+			if (!ok)
+				log_cb(RETRO_LOG_ERROR, "(FileMcd) Could not write memory card data (%d) [%08X]\n", slot, (u32)begin);
+
+			i = j;
+		}
 	}
+}
+
+void FileMemoryCard::WriterThread()
+{
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	while (!m_writer_exit)
+	{
+		if (!m_pending)
+		{
+			m_cv.wait(lock);
+			continue;
+		}
+
+		// consecutive sector writes of a save are coalesced into one write per run of chunks
+		m_cv.wait_for(lock, std::chrono::milliseconds(MCD_FLUSH_DELAY_MS), [this] { return m_writer_exit; });
+
+		m_pending = false;
 
-	return f.Seek(adr + offset);
+		Flush(lock);
+	}
 }
 
 // returns FALSE if an error occurred (either permission denied or disk full)
@@ -417,7 +594,7 @@ void FileMemoryCard::GetSizeInfo(uint slot, McdSizeInfo& outways)
 	outways.Xor = 18;                     // 0x12, XOR 02 00 00 10
 
 	if (pxAssert(m_file[slot].IsOpened()))
-		outways.McdSizeInSectors = m_file[slot].Length() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
+		outways.McdSizeInSectors = m_image[slot].size() / (outways.SectorSize + outways.EraseBlockSizeInSectors);
 	else
 		outways.McdSizeInSectors = 0x4000;
 
@@ -432,47 +609,56 @@ bool FileMemoryCard::IsPSX(uint slot)
 
 s32 FileMemoryCard::Read(uint slot, u8* dest, u32 adr, int size)
 {
-	wxFFile& mcfp(m_file[slot]);
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		log_cb(RETRO_LOG_ERROR, "(FileMcd) Ignoring attempted read from disabled slot.\n");
 		memset(dest, 0, size);
 		return 1;
 	}
-	if (!Seek(mcfp, adr))
+
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	const std::vector<u8>& image = m_image[slot];
+	const size_t pos = (size_t)adr + m_offset[slot];
+
+	if (pos >= image.size())
 		return 0;
-	return mcfp.Read(dest, size) != 0;
+
+	memcpy(dest, &image[pos], std::min<size_t>(size, image.size() - pos));
+	return 1;
 }
 
 s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 {
-	wxFFile& mcfp(m_file[slot]);
-
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		log_cb(RETRO_LOG_ERROR, "(FileMcd) Ignoring attempted save/write to disabled slot.\n");
 		return 1;
 	}
 
+	std::unique_lock<std::mutex> lock(m_lock);
+
+	std::vector<u8>& image = m_image[slot];
+	const size_t pos = (size_t)adr + m_offset[slot];
+
+	if (size <= 0 || pos + size > image.size())
+		return 0;
+
+	u8* data = &image[pos];
+
 	if (m_ispsx[slot])
 	{
-		m_currentdata.MakeRoomFor(size);
-		for (int i = 0; i < size; i++)
-			m_currentdata[i] = src[i];
+		XorPSXChecksum(slot, pos, pos + size);
+		memcpy(data, src, size);
+		XorPSXChecksum(slot, pos, pos + size);
 	}
 	else
 	{
-		if (!Seek(mcfp, adr))
-			return 0;
-		m_currentdata.MakeRoomFor(size);
-		mcfp.Read(m_currentdata.GetPtr(), size);
-
-
 		for (int i = 0; i < size; i++)
 		{
-			if ((m_currentdata[i] & src[i]) != src[i])
+			if ((data[i] & src[i]) != src[i])
 				log_cb(RETRO_LOG_WARN, "(FileMcd) Warning: writing to uncleared data. (%d) [%08X]\n", slot, adr);
-			m_currentdata[i] &= src[i];
+			data[i] &= src[i];
 		}
 
 		// Checksumness
@@ -480,83 +666,72 @@ s32 FileMemoryCard::Save(uint slot, const u8* src, u32 adr, int size)
 			if (adr == m_chkaddr)
 				log_cb(RETRO_LOG_WARN, "(FileMcd) Warning: checksum sector overwritten. (%d)\n", slot);
 
-			u64* pdata = (u64*)&m_currentdata[0];
 			u32 loops = size / 8;
 
 			for (u32 i = 0; i < loops; i++)
-				m_chksum[slot] ^= pdata[i];
+			{
+				u64 v;
+				memcpy(&v, &data[i * 8], 8);
+				m_chksum[slot] ^= v;
+			}
 		}
 	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
+	MarkDirty(slot, pos, pos + size);
+	m_cv.notify_one();
 
-	int status = mcfp.Write(m_currentdata.GetPtr(), size);
+	static auto last = std::chrono::time_point<std::chrono::system_clock>();
 
-	if (status)
+	std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
+	if (elapsed > std::chrono::seconds(5))
 	{
-		static auto last = std::chrono::time_point<std::chrono::system_clock>();
-
-		std::chrono::duration<float> elapsed = std::chrono::system_clock::now() - last;
-		if (elapsed > std::chrono::seconds(5))
-		{
-			wxString name, ext;
-			wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
-			log_cb(RETRO_LOG_INFO, "Memory Card %s written.\n", (const char*)(name + "." + ext).c_str());
-			last = std::chrono::system_clock::now();
-		}
-		return 1;
+		wxString name, ext;
+		wxFileName::SplitPath(m_file[slot].GetName(), NULL, NULL, &name, &ext);
+		log_cb(RETRO_LOG_INFO, "Memory Card %s written.\n", (const char*)(name + "." + ext).c_str());
+		last = std::chrono::system_clock::now();
 	}
 
-	return 0;
+	return 1;
 }
 
 s32 FileMemoryCard::EraseBlock(uint slot, u32 adr)
 {
-	wxFFile& mcfp(m_file[slot]);
-
-	if (!mcfp.IsOpened())
+	if (!m_file[slot].IsOpened())
 	{
 		log_cb(RETRO_LOG_ERROR, "MemoryCard: Ignoring erase for disabled slot.\n");
 		return 1;
 	}
 
-	if (!Seek(mcfp, adr))
-		return 0;
-	return mcfp.Write(m_effeffs, sizeof(m_effeffs)) != 0;
-}
+	std::unique_lock<std::mutex> lock(m_lock);
 
-u64 FileMemoryCard::GetCRC(uint slot)
-{
-	wxFFile& mcfp(m_file[slot]);
-	if (!mcfp.IsOpened())
+	std::vector<u8>& image = m_image[slot];
+	const size_t pos = (size_t)adr + m_offset[slot];
+
+	if (pos + sizeof(m_effeffs) > image.size())
 		return 0;
 
-	u64 retval = 0;
+	if (m_ispsx[slot])
+		XorPSXChecksum(slot, pos, pos + sizeof(m_effeffs));
+
+	memcpy(&image[pos], m_effeffs, sizeof(m_effeffs));
 
 	if (m_ispsx[slot])
-	{
-		if (!Seek(mcfp, 0))
-			return 0;
+		XorPSXChecksum(slot, pos, pos + sizeof(m_effeffs));
 
-		// Process the file in 4k chunks.  Speeds things up significantly.
+	MarkDirty(slot, pos, pos + sizeof(m_effeffs));
+	m_cv.notify_one();
 
-		u64 buffer[528 * 8]; // use 528 (sector size), ensures even divisibility
+	return 1;
+}
 
-		const uint filesize = mcfp.Length() / sizeof(buffer);
-		for (uint i = filesize; i; --i)
-		{
-			mcfp.Read(&buffer, sizeof(buffer));
-			for (uint t = 0; t < ArraySize(buffer); ++t)
-				retval ^= buffer[t];
-		}
-	}
-	else
-	{
-		retval = m_chksum[slot];
-	}
+u64 FileMemoryCard::GetCRC(uint slot)
+{
+	if (!m_file[slot].IsOpened())
+		return 0;
+
+	std::unique_lock<std::mutex> lock(m_lock);
 
-	return retval;
+	return m_chksum[slot];
 }
 
 // --------------------------------------------------------------------------------------
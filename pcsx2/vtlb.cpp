@@ -568,6 +568,18 @@ __fi void* vtlb_GetPhyPtr(u32 paddr)
 		return reinterpret_cast<void*>(vtlbdata.pmap[paddr>>VTLB_PAGE_BITS].assumePtr()+(paddr&VTLB_PAGE_MASK));
 }
 
+// Same for a virtual address, NULL when it's accessed through a handler (registers, or
+// a TLB miss which would raise a guest exception).
+__fi void* vtlb_GetVirtPtr(u32 vaddr)
+{
+	auto vmv = vtlbdata.vmap[vaddr>>VTLB_PAGE_BITS];
+
+	if (vmv.isHandler(vaddr))
+		return NULL;
+	else
+		return reinterpret_cast<void*>(vmv.assumePtr(vaddr));
+}
+
 __fi u32 vtlb_V2P(u32 vaddr)
 {
 	u32 paddr = vtlbdata.ppmap[vaddr>>VTLB_PAGE_BITS];
@@ -35,6 +35,7 @@ struct BASEBLOCKEX
 	uptr fnptr;
 	u16  size;	 // The size in dwords (equivalent to the number of instructions)
 	u16  x86size; // The size in byte of the translated x86 instructions
+	u16  intcalls; // Number of interpreter fallbacks emitted in the block
 
 #ifdef PCSX2_DEVBUILD
 	// Could be useful to instrument the block
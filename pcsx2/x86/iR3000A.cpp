@@ -77,6 +77,66 @@ static EEINST* s_psaveInstInfo = NULL;
 u32 s_psxBlockCycles = 0; // cycles of current block recompiling
 static u32 s_savenBlockCycles = 0;
 
+// Superblocks: the block scan carries on past conditional branches whose
+// target lies outside the block, so the not-taken path is compiled inline
+// with its const and register state instead of ending the block. The taken
+// path still leaves through psxSetBranchImm. Bounded so event tests stay
+// frequent enough.
+static const u32 PSX_SUPERBLOCK_MAX_BRANCHES = 8;
+static const u32 PSX_SUPERBLOCK_MAX_SIZE = 64 * 4; // bytes scanned before a branch may be passed
+
+// Set to 1 to count the executions of every IOP block. The hottest ones are
+// logged when the recompiler is reset or shut down.
+#define PSX_BLOCK_HISTOGRAM 0
+
+#if PSX_BLOCK_HISTOGRAM
+struct psxBlockProfile
+{
+	u32 startpc;
+	u32 size; // in instructions
+	u32 hits;
+};
+
+static psxBlockProfile s_psxBlockProfile[0x8000];
+static u32 s_psxBlockProfileCount = 0;
+
+static void psxReportBlockHistogram()
+{
+	if (!s_psxBlockProfileCount)
+		return;
+
+	// Blocks can be compiled several times, merge them by start pc
+	std::map<u32, psxBlockProfile> merged;
+	u64 total = 0;
+	for (u32 i = 0; i < s_psxBlockProfileCount; i++)
+	{
+		const psxBlockProfile& p = s_psxBlockProfile[i];
+		psxBlockProfile& m = merged[p.startpc];
+		m.startpc = p.startpc;
+		m.size = std::max(m.size, p.size);
+		m.hits += p.hits;
+		total += (u64)p.hits * p.size;
+	}
+
+	std::vector<psxBlockProfile> sorted;
+	for (const auto& it : merged)
+		sorted.push_back(it.second);
+	std::sort(sorted.begin(), sorted.end(), [](const psxBlockProfile& a, const psxBlockProfile& b) {
+		return (u64)a.hits * a.size > (u64)b.hits * b.size;
+	});
+
+	log_cb(RETRO_LOG_DEBUG, "IOP block histogram: %u blocks, %llu instructions\n", (u32)sorted.size(), (unsigned long long)total);
+	for (size_t i = 0; i < std::min<size_t>(sorted.size(), 32); i++)
+	{
+		const psxBlockProfile& p = sorted[i];
+		log_cb(RETRO_LOG_DEBUG, "  %08x: %5u insts %10u hits %5.2f%%\n", p.startpc, p.size, p.hits,
+			total ? 100.0 * p.hits * p.size / total : 0.0);
+	}
+
+	s_psxBlockProfileCount = 0;
+}
+#endif
+
 static void iPsxBranchTest(u32 newpc, u32 cpuBranch);
 void psxRecompileNextInstruction(int delayslot);
 
@@ -602,6 +662,10 @@ void recResetIOP()
 {
 	log_cb(RETRO_LOG_DEBUG, "iR3000A Recompiler reset.\n" );
 
+#if PSX_BLOCK_HISTOGRAM
+	psxReportBlockHistogram();
+#endif
+
 	recAlloc();
 	recMem->Reset();
 
@@ -655,10 +719,15 @@ void recResetIOP()
 
 	recPtr = *recMem;
 	psxbranch = 0;
+	RecCacheStats::SetUsage(RecCache_IOP, 0, recMem->GetReserveSizeInBytes());
 }
 
 static void recShutdown()
 {
+#if PSX_BLOCK_HISTOGRAM
+	psxReportBlockHistogram();
+#endif
+
 	safe_delete( recMem );
 
 	safe_aligned_free( m_recBlockAlloc );
@@ -813,6 +882,15 @@ void psxSetBranchReg(u32 reg)
 
 void psxSetBranchImm( u32 imm )
 {
+	// Not-taken path of a conditional branch the block scan went past: keep
+	// compiling the superblock. The branch ops emit this path last, after the
+	// taken path has set psxbranch, so clear it again for the compile loop.
+	if (imm == psxpc && psxpc < s_nEndBlock)
+	{
+		psxbranch = 0;
+		return;
+	}
+
 	psxbranch = 1;
 	pxAssert( imm );
 
@@ -961,10 +1039,25 @@ void psxRecompileNextInstruction(int delayslot)
 	_clearNeededX86regs();
 }
 
+// Whether the block scan can go on past the conditional branch at pc, which
+// jumps to s_branchTo. Backward branches to the block start are left alone,
+// they are loops and the wait loop detection needs them at the block end.
+static __fi bool psxCanPassBranch(u32 startpc, u32 pc, u32 passedBranches)
+{
+	if (passedBranches >= PSX_SUPERBLOCK_MAX_BRANCHES || pc + 8 - startpc > PSX_SUPERBLOCK_MAX_SIZE)
+		return false;
+
+	// The taken path must leave the block. Targets in the delay slot or
+	// right after it would be emitted as a fall-through.
+	return s_branchTo < startpc || s_branchTo > pc + 8;
+}
+
 static void __fastcall iopRecRecompile( const u32 startpc )
 {
 	u32 i;
 	u32 willbranch3 = 0;
+	bool superblock = true;
+	u32 passedBranches;
 
 	// Inject IRX hack
 	if (startpc == 0x1630 && g_Conf->CurrentIRX.Length() > 3) {
@@ -978,6 +1071,7 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 
 	// if recPtr reached the mem limit reset whole mem
 	if (recPtr >= (recMem->GetPtrEnd() - _64kb)) {
+		RecCacheStats::ScopedFlush flush(RecCache_IOP);
 		recResetIOP();
 	}
 
@@ -1000,6 +1094,18 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 	s_pCurBlock->SetFnptr( (uptr)x86Ptr );
 	s_psxBlockCycles = 0;
 
+#if PSX_BLOCK_HISTOGRAM
+	psxBlockProfile* profile = nullptr;
+	if (s_psxBlockProfileCount < ArraySize(s_psxBlockProfile))
+	{
+		profile = &s_psxBlockProfile[s_psxBlockProfileCount++];
+		profile->startpc = startpc;
+		profile->size = 0;
+		profile->hits = 0;
+		xADD(ptr32[&profile->hits], 1);
+	}
+#endif
+
 	// reset recomp state variables
 	psxpc = startpc;
 	g_psxHasConstReg = g_psxFlushedConstReg = 1;
@@ -1013,9 +1119,11 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 	}
 
 	// go until the next branch
+ScanBlock:
 	i = startpc;
 	s_nEndBlock = 0xffffffff;
 	s_branchTo = -1;
+	passedBranches = 0;
 
 	while(1) {
 		BASEBLOCK* pblock = PSX_GETBLOCK(i);
@@ -1044,7 +1152,15 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 				if( _Rt_ == 0 || _Rt_ == 1 || _Rt_ == 16 || _Rt_ == 17 ) {
 
 					s_branchTo = _Imm_ * 4 + i + 4;
-					if( s_branchTo > startpc && s_branchTo < i ) s_nEndBlock = s_branchTo;
+					if( s_branchTo > startpc && s_branchTo < i ) {
+						if (passedBranches) { superblock = false; goto ScanBlock; }
+						s_nEndBlock = s_branchTo;
+					}
+					else if (superblock && _Rs_ != 0 && psxCanPassBranch(startpc, i, passedBranches)) {
+						passedBranches++;
+						i += 8;
+						continue;
+					}
 					else  s_nEndBlock = i+8;
 
 					goto StartRecomp;
@@ -1062,7 +1178,15 @@ static void __fastcall iopRecRecompile( const u32 startpc )
 			case 4: case 5: case 6: case 7:
 
 				s_branchTo = _Imm_ * 4 + i + 4;
-				if( s_branchTo > startpc && s_branchTo < i ) s_nEndBlock = s_branchTo;
+				if( s_branchTo > startpc && s_branchTo < i ) {
+					if (passedBranches) { superblock = false; goto ScanBlock; }
+					s_nEndBlock = s_branchTo;
+				}
+				else if (superblock && !((psxRegs.code >> 26) == 4 && _Rs_ == _Rt_) && psxCanPassBranch(startpc, i, passedBranches)) {
+					passedBranches++;
+					i += 8;
+					continue;
+				}
 				else  s_nEndBlock = i+8;
 
 				goto StartRecomp;
@@ -1119,6 +1243,11 @@ StartRecomp:
 	pxAssert( (psxpc-startpc)>>2 <= 0xffff );
 	s_pCurBlockEx->size = (psxpc-startpc)>>2;
 
+#if PSX_BLOCK_HISTOGRAM
+	if (profile)
+		profile->size = s_pCurBlockEx->size;
+#endif
+
 	for(i = 1; i < (u32)s_pCurBlockEx->size; ++i) {
 		if (s_pCurBlock[i].GetFnptr() == (uptr)iopJITCompile)
 			s_pCurBlock[i].SetFnptr((uptr)iopJITCompileInBlock);
@@ -1157,6 +1286,7 @@ StartRecomp:
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
 	recPtr = xGetPtr();
+	RecCacheStats::SetUsage(RecCache_IOP, recPtr - recMem->GetPtr(), recMem->GetReserveSizeInBytes());
 
 	pxAssert( (g_psxHasConstReg&g_psxFlushedConstReg) == g_psxHasConstReg );
 
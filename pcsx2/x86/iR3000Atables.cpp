@@ -1004,21 +1004,23 @@ void rpsxJALR()
 //// BEQ
 static u32* s_pbranchjmp;
 
-void rpsxSetBranchEQ(int info, int process)
+// Conditional branches emit their taken path first and their not-taken path
+// last, so the latter can carry on into the rest of a superblock. The jumps
+// emitted here lead to the not-taken path.
+void rpsxSetBranchEQ(int info, int process, bool jumpIfEqual)
 {
 	if( process & PROCESS_CONSTS ) {
 		xCMP(ptr32[&psxRegs.GPR.r[ _Rt_ ]], g_psxConstRegs[_Rs_] );
-		s_pbranchjmp = JNE32( 0 );
 	}
 	else if( process & PROCESS_CONSTT ) {
 		xCMP(ptr32[&psxRegs.GPR.r[ _Rs_ ]], g_psxConstRegs[_Rt_] );
-		s_pbranchjmp = JNE32( 0 );
 	}
 	else {
 		xMOV(eax, ptr32[&psxRegs.GPR.r[ _Rs_ ] ]);
 		xCMP(eax, ptr32[&psxRegs.GPR.r[ _Rt_ ] ]);
-		s_pbranchjmp = JNE32( 0 );
 	}
+
+	s_pbranchjmp = jumpIfEqual ? JE32( 0 ) : JNE32( 0 );
 }
 
 void rpsxBEQ_const()
@@ -1048,7 +1050,7 @@ void rpsxBEQ_process(int info, int process)
 		_psxFlushAllUnused();
 		psxSaveBranchState();
 
-		rpsxSetBranchEQ(info, process);
+		rpsxSetBranchEQ(info, process, false);
 
 		psxRecompileNextInstruction(1);
 		psxSetBranchImm(branchTo);
@@ -1095,11 +1097,11 @@ void rpsxBNE_process(int info, int process)
 	}
 
 	_psxFlushAllUnused();
-	rpsxSetBranchEQ(info, process);
+	rpsxSetBranchEQ(info, process, true);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( s_pbranchjmp );
 
@@ -1108,7 +1110,7 @@ void rpsxBNE_process(int info, int process)
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 void rpsxBNE_(int info) { rpsxBNE_process(info, 0); }
@@ -1134,12 +1136,12 @@ void rpsxBLTZ()
 	}
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JL32(0);
+	u32* pjmp = JGE32(0);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
@@ -1148,7 +1150,7 @@ void rpsxBLTZ()
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 //// BGEZ
@@ -1168,12 +1170,12 @@ void rpsxBGEZ()
 	}
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JGE32(0);
+	u32* pjmp = JL32(0);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
@@ -1182,7 +1184,7 @@ void rpsxBGEZ()
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 //// BLTZAL
@@ -1208,13 +1210,13 @@ void rpsxBLTZAL()
 	}
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JL32(0);
+	u32* pjmp = JGE32(0);
 
 	psxSaveBranchState();
 
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
@@ -1223,7 +1225,7 @@ void rpsxBLTZAL()
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 //// BGEZAL
@@ -1248,12 +1250,12 @@ void rpsxBGEZAL()
 	}
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JGE32(0);
+	u32* pjmp = JL32(0);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
@@ -1262,7 +1264,7 @@ void rpsxBGEZAL()
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
 
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 //// BLEZ
@@ -1286,18 +1288,18 @@ void rpsxBLEZ()
 	_clearNeededX86regs();
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JLE32(0);
+	u32* pjmp = JG32(0);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
 	psxpc -= 4;
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 //// BGTZ
@@ -1321,18 +1323,18 @@ void rpsxBGTZ()
 	_clearNeededX86regs();
 
 	xCMP(ptr32[&psxRegs.GPR.r[_Rs_]], 0);
-	u32* pjmp = JG32(0);
+	u32* pjmp = JLE32(0);
 
 	psxSaveBranchState();
 	psxRecompileNextInstruction(1);
-	psxSetBranchImm(psxpc);
+	psxSetBranchImm(branchTo);
 
 	x86SetJ32A( pjmp );
 
 	psxpc -= 4;
 	psxLoadBranchState();
 	psxRecompileNextInstruction(1);
-	psxSetBranchImm(branchTo);
+	psxSetBranchImm(psxpc);
 }
 
 void rpsxMFC0()
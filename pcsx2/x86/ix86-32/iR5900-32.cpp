@@ -297,6 +297,9 @@ void recBranchCall( void (*func)() )
 
 void recCall( void (*func)() )
 {
+	if (s_pCurBlockEx && s_pCurBlockEx->intcalls < 0xffff)
+		s_pCurBlockEx->intcalls++;
+
 	iFlushCall(FLUSH_INTERPRETER);
 	xFastCall((void*)func);
 }
@@ -603,6 +606,7 @@ static void recResetRaw()
 
 	recPtr = *recMem;
 	recConstBufPtr = recConstBuf;
+	RecCacheStats::SetUsage(RecCache_EE, 0, recMem->GetReserveSizeInBytes());
 
 	g_branch = 0;
 	g_resetEeScalingStats = true;
@@ -816,7 +820,10 @@ void recClear(u32 addr, u32 size)
 	}
 
 	if (upperextent > lowerextent)
+	{
 		ClearRecLUT(PC_GETBLOCK(lowerextent), upperextent - lowerextent);
+		RecCacheStats::CountClear(lowerextent, upperextent);
+	}
 }
 
 
@@ -1181,6 +1188,23 @@ void __fastcall dynarecMemLogcheck(u32 start, bool store)
 #endif
 }
 
+// Past this many ranges one tree lookup beats the inline compares
+static const size_t MemcheckInlineRanges = 4;
+
+template< bool store >
+static void __fastcall dynarecMemcheckTree(u32 start, u32 end)
+{
+	u32 result = 0;
+	CBreakPoints::GetMemCheckTree(store).ForEachOverlap(start, end, [&](const IntervalTree<MemCheckResult>::Node& check) {
+		result |= check.value;
+	});
+
+	if (result & MEMCHECK_LOG)
+		dynarecMemLogcheck(start, store);
+	if (result & MEMCHECK_BREAK)
+		dynarecMemcheck();
+}
+
 void recMemcheck(u32 op, u32 bits, bool store)
 {
 	iFlushCall(FLUSH_EVERYTHING|FLUSH_PC);
@@ -1200,32 +1224,31 @@ void recMemcheck(u32 op, u32 bits, bool store)
 	// ecx = access address
 	// edx = access address+size
 
-	auto checks = CBreakPoints::GetMemChecks();
-	for (size_t i = 0; i < checks.size(); i++)
+	const auto& checks = CBreakPoints::GetMemCheckTree(store).GetNodes();
+	if (checks.size() > MemcheckInlineRanges)
 	{
-		if (checks[i].result == 0)
-			continue;
-		if ((checks[i].cond & MEMCHECK_WRITE) == 0 && store)
-			continue;
-		if ((checks[i].cond & MEMCHECK_READ) == 0 && !store)
-			continue;
+		xFastCall(store ? (void*)dynarecMemcheckTree<true> : (void*)dynarecMemcheckTree<false>, ecx, edx);
+		return;
+	}
 
+	for (size_t i = 0; i < checks.size(); i++)
+	{
 		// logic: memAddress < bpEnd && bpStart < memAddress+memSize
 
-		xMOV(eax,standardizeBreakpointAddress(checks[i].end));
+		xMOV(eax,(u32)checks[i].end);
 		xCMP(ecx,eax);				// address < end
 		xForwardJGE8 next1;			// if address >= end then goto next1
 
-		xMOV(eax,standardizeBreakpointAddress(checks[i].start));
+		xMOV(eax,checks[i].start);
 		xCMP(eax,edx);				// start < address+size
 		xForwardJGE8 next2;			// if start >= address+size then goto next2
 
 		// hit the breakpoint
-		if (checks[i].result & MEMCHECK_LOG) {
+		if (checks[i].value & MEMCHECK_LOG) {
 			xMOV(edx, store);
 			xFastCall((void*)dynarecMemLogcheck, ecx, edx);
 		}
-		if (checks[i].result & MEMCHECK_BREAK) {
+		if (checks[i].value & MEMCHECK_BREAK) {
 			xFastCall((void*)dynarecMemcheck);
 		}
 
@@ -1470,6 +1493,7 @@ static u32 s_recblocks[] = {0};
 void __fastcall dyna_block_discard(u32 start,u32 sz)
 {
 	//log_cb(RETRO_LOG_DEBUG, "Clearing Manual Block @ 0x%08X  [size=%d]\n", start, sz*4);
+	RecCacheStats::CountInvalidation(RecInvalidate_BlockCheck);
 	recClear(start, sz);
 }
 
@@ -1478,6 +1502,7 @@ void __fastcall dyna_block_discard(u32 start,u32 sz)
 // and the block is re-assigned for write protection.
 void __fastcall dyna_page_reset(u32 start,u32 sz)
 {
+	RecCacheStats::CountInvalidation(RecInvalidate_PageReset);
 	recClear(start & ~0xfffUL, 0x400);
 	manual_counter[start >> 12]++;
 	mmap_MarkCountedRamPage( start );
@@ -1601,15 +1626,20 @@ static void __fastcall recRecompile( const u32 startpc )
 	pxAssert( startpc );
 
 	// if recPtr reached the mem limit reset whole mem
+	bool cacheFull = false;
 	if (recPtr >= (recMem->GetPtrEnd() - _64kb)) {
-		eeRecNeedsReset = true;
+		eeRecNeedsReset = cacheFull = true;
 	}
 	else if ((recConstBufPtr - recConstBuf) >= RECCONSTBUF_SIZE - 64) {
 		log_cb(RETRO_LOG_DEBUG, "EE recompiler stack reset\n");
-		eeRecNeedsReset = true;
+		eeRecNeedsReset = cacheFull = true;
 	}
 
-	if (eeRecNeedsReset) recResetRaw();
+	if (eeRecNeedsReset)
+	{
+		RecCacheStats::ScopedFlush flush(RecCache_EE, cacheFull);
+		recResetRaw();
+	}
 
 	xSetPtr( recPtr );
 	recPtr = xGetAlignedCallTarget();
@@ -2051,6 +2081,7 @@ StartRecomp:
 	s_pCurBlockEx->x86size = xGetPtr() - recPtr;
 
 	recPtr = xGetPtr();
+	RecCacheStats::SetUsage(RecCache_EE, recPtr - recMem->GetPtr(), recMem->GetReserveSizeInBytes());
 
 	pxAssert( (g_cpuHasConstReg&g_cpuFlushedConstReg) == g_cpuHasConstReg );
 
@@ -2093,6 +2124,17 @@ static uint recGetCacheReserve()
 	return m_ConfiguredCacheReserve;
 }
 
+bool recLookupBlock(u32 pc, u32& startpc, u32& size, u32& intcalls)
+{
+	BASEBLOCKEX* pblock = recBlocks.Get(HWADDR(pc));
+	if (!pblock) return false;
+
+	startpc  = pblock->startpc;
+	size     = pblock->size;
+	intcalls = pblock->intcalls;
+	return true;
+}
+
 R5900cpu recCpu =
 {
 	recReserve,
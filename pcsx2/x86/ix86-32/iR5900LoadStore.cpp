@@ -23,6 +23,8 @@
 
 using namespace x86Emitter;
 
+extern void COP2_WaitThread();
+
 #define REC_STORES
 #define REC_LOADS
 
@@ -560,10 +562,10 @@ void recSWC1()
 #define _Fd_ _Sa_
 
 
-
 void recLQC2()
 {
 	iFlushCall(FLUSH_EVERYTHING);
+	COP2_WaitThread();
 
 	xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 	xForwardJZ32 skipvuidle;
@@ -608,6 +610,7 @@ void recLQC2()
 void recSQC2()
 {
 	iFlushCall(FLUSH_EVERYTHING);
+	COP2_WaitThread();
 
 	xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 	xForwardJZ32 skipvuidle;
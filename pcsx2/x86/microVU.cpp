@@ -67,6 +67,7 @@ void mVUinit(microVU& mVU, uint vuIndex) {
 	else mVU.dispCache = vu0_RecDispatchers;
 
 	mVU.regAlloc.reset(new microRegAlloc(mVU.index));
+	mVU.analysis.reset(new microAnalysisCache());
 }
 
 // Resets Rec Data
@@ -77,12 +78,21 @@ void mVUreset(microVU& mVU, bool resetReserve) {
 		if (VU0.VI[REG_VPU_STAT].UL & 0x100)
 		{
 			CpuVU1->Execute(vu1RunCycles);
+			VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 		}
-		VU0.VI[REG_VPU_STAT].UL &= ~0x100;
 	}
 	// Restore reserve to uncommitted state
 	if (resetReserve) mVU.cache_reserve->Reset();
 
+	// Keep first pass results over cache-full resets, the same code will be compiled again
+	if (resetReserve) {
+#ifndef NDEBUG
+		if (mVU.analysis->hits || mVU.analysis->misses)
+			log_cb(RETRO_LOG_DEBUG, "microVU%d: Analysis cache %u hits, %u misses\n", mVU.index, mVU.analysis->hits, mVU.analysis->misses);
+#endif
+		mVU.analysis->reset();
+	}
+
 	HostSys::MemProtect(mVU.dispCache, mVUdispCacheSize, PageAccess_ReadWrite());
 	memset(mVU.dispCache, 0xcc, mVUdispCacheSize);
 
@@ -106,6 +116,7 @@ void mVUreset(microVU& mVU, bool resetReserve) {
 	mVU.prog.x86start	= z;
 	mVU.prog.x86ptr		= z;
 	mVU.prog.x86end		= z + ((mVU.cacheSize - mVUcacheSafeZone) * _1mb);
+	RecCacheStats::SetUsage(mVU.index ? RecCache_VU1 : RecCache_VU0, 0, mVU.prog.x86end - mVU.prog.x86start);
 
 	for(u32 i = 0; i < (mVU.progSize / 2); i++) {
 		if(!mVU.prog.prog[i]) {
@@ -318,12 +329,14 @@ _mVUt __fi void* mVUsearchProg(u32 startPC, uptr pState) {
 //------------------------------------------------------------------
 recMicroVU0::recMicroVU0()		  { m_Idx = 0; IsInterpreter = false; }
 recMicroVU1::recMicroVU1()		  { m_Idx = 1; IsInterpreter = false; }
-void recMicroVU0::Vsync() noexcept { mVUvsyncUpdate(microVU0); }
+void recMicroVU0::Vsync() noexcept { vu0Thread.WaitVU(); mVUvsyncUpdate(microVU0); }
 void recMicroVU1::Vsync() noexcept { mVUvsyncUpdate(microVU1); }
 
 void recMicroVU0::Reserve() {
-	if (m_Reserved.exchange(1) == 0)
+	if (m_Reserved.exchange(1) == 0) {
 		mVUinit(microVU0, 0);
+		vu0Thread.Start();
+	}
 }
 void recMicroVU1::Reserve() {
 	if (m_Reserved.exchange(1) == 0) {
@@ -333,8 +346,10 @@ void recMicroVU1::Reserve() {
 }
 
 void recMicroVU0::Shutdown() noexcept {
-	if (m_Reserved.exchange(0) == 1)
+	if (m_Reserved.exchange(0) == 1) {
+		vu0Thread.WaitVU();
 		mVUclose(microVU0);
+	}
 }
 void recMicroVU1::Shutdown() noexcept {
 	if (m_Reserved.exchange(0) == 1) {
@@ -345,6 +360,7 @@ void recMicroVU1::Shutdown() noexcept {
 
 void recMicroVU0::Reset() {
 	if(!pxAssertDev(m_Reserved, "MicroVU0 CPU Provider has not been reserved prior to reset!")) return;
+	vu0Thread.WaitVU();
 	mVUreset(microVU0, true);
 }
 void recMicroVU1::Reset() {
@@ -371,7 +387,7 @@ void recMicroVU0::Execute(u32 cycles) {
 	// Edit: Need to test this again, if anyone ever has a "Woody" game :p
 	((mVUrecCall)microVU0.startFunct)(VU0.VI[REG_TPC].UL, cycles);
 	VU0.VI[REG_TPC].UL >>= 3;
-	if(microVU0.regs().flags & 0x4)
+	if(microVU0.regs().flags & 0x4 && !THREAD_VU0) // Else raised by vu0Thread on the EE
 	{
 		microVU0.regs().flags &= ~0x4;
 		hwIntcIrq(6);
@@ -401,6 +417,7 @@ void recMicroVU1::Execute(u32 cycles) {
 
 void recMicroVU0::Clear(u32 addr, u32 size) {
 	pxAssert(m_Reserved); // please allocate me first! :|
+	vu0Thread.WaitVU();
 	mVUclear(microVU0, addr, size);
 }
 void recMicroVU1::Clear(u32 addr, u32 size) {
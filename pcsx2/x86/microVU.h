@@ -191,6 +191,7 @@ struct microVU {
 
 	microProgManager				prog;		// Micro Program Data
 	std::unique_ptr<microRegAlloc>	regAlloc;	// Reg Alloc Class
+	std::unique_ptr<microAnalysisCache> analysis; // First pass results of compiled blocks
 
 	RecompiledCodeReserve* cache_reserve;
 	u8*		cache;		  // Dynarec Cache Start (where we will start writing the recompiled code to)
@@ -530,7 +530,7 @@ void mVUDoDBit(microVU& mVU, microFlagCycles* mFC)
 {
 	xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x400 : 0x4));
 	xForwardJump32 eJMP(Jcc_Zero);
-	xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x200 : 0x2));
+	xOR(ptr32[mVUvpuStat(mVU)], (isVU1 ? 0x200 : 0x2));
 	xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
 	incPC(1);
 	mVUDTendProgram(mVU, mFC, 1);
@@ -542,7 +542,7 @@ void mVUDoTBit(microVU& mVU, microFlagCycles* mFC)
 {
 	xTEST(ptr32[&VU0.VI[REG_FBRST].UL], (isVU1 ? 0x800 : 0x8));
 	xForwardJump32 eJMP(Jcc_Zero);
-	xOR(ptr32[&VU0.VI[REG_VPU_STAT].UL], (isVU1 ? 0x400 : 0x4));
+	xOR(ptr32[mVUvpuStat(mVU)], (isVU1 ? 0x400 : 0x4));
 	xOR(ptr32[&mVU.regs().flags], VUFLAG_INTCINTERRUPT);
 	incPC(1);
 	mVUDTendProgram(mVU, mFC, 1);
@@ -556,11 +556,94 @@ void mVUSaveFlags(microVU& mVU,microFlagCycles &mFC, microFlagCycles &mFCBackup)
 	memcpy(&mFCBackup, &mFC, sizeof(microFlagCycles));
 	mVUsetFlags(mVU, mFCBackup);	   // Sets Up Flag instances
 }
+
+// The I-bit hack sets up program ranges from the first pass, so it can't be skipped
+__fi bool mVUcanCacheAnalysis(mV) { return !EmuConfig.Gamefixes.IbitHack; }
+
+__fi u64 mVUanalysisHash(mV, const microRegInfo& pState) {
+	return microAnalysisCache::getHash(mVUstartPC, pState, mVUpBlock->pState, ((u64*)mVU.regs().Micro)[mVUstartPC / 2]);
+}
+
+// Restores the first pass results of the block if it was analyzed before
+// from the same pipeline state, with the same code
+bool mVUloadAnalysis(mV, const microRegInfo& pState, microFlagCycles& mFC)
+{
+	if (!mVUcanCacheAnalysis(mVU)) return false;
+
+	microAnalysis* a = mVU.analysis->find(mVUanalysisHash(mVU, pState));
+	bool found = a && (a->startPC == mVUstartPC) && (a->sFlagHack == mVUsFlagHack)
+		&& !memcmp(&a->pState, &pState, sizeof(microRegInfo))
+		&& !memcmp(&a->pBlockState, &mVUpBlock->pState, sizeof(microRegInfo));
+	for (u32 i = 0; found && i < a->codePC.size(); i++) {
+		found = ((u64*)mVU.regs().Micro)[a->codePC[i]] == a->code[i];
+	}
+	if (!found) {
+		mVU.analysis->misses++;
+		return false;
+	}
+	mVU.analysis->hits++;
+
+	const u32 pcMask = mVU.progMemMask / 2;
+	for (u32 i = 0; i < a->count; i++) {
+		mVU.prog.IRinfo.info[(mVUstartPC / 2 + i) & pcMask] = a->info[i];
+	}
+	memcpy(&mVUregs, &a->pStateEnd, sizeof(microRegInfo));
+	memcpy(&mVUregsTemp, &a->regsTemp, sizeof(microTempRegInfo));
+	memcpy(mVUconstReg, a->constReg, sizeof(a->constReg));
+	mFC		   = a->mFC;
+	mVUcount   = a->count;
+	mVUcycles  = a->cycles;
+	mVU.p	   = a->p;
+	mVU.q	   = a->q;
+	return true;
+}
+
+// Stores the first pass results of the block, with the code they were based on
+void mVUsaveAnalysis(mV, const microRegInfo& pState, const microFlagCycles& mFC)
+{
+	if (!mVUcanCacheAnalysis(mVU)) return;
+
+	microAnalysis& a = mVU.analysis->add(mVUanalysisHash(mVU, pState));
+	const u32 pcMask = mVU.progMemMask / 2;
+	const u32 pc = mVUstartPC / 2;
+
+	// The block, and the instruction before it (M-bit and branch delay slot checks)
+	mVU.analysis->markRead((pc - 1) & pcMask);
+	for (u32 i = 0; i < mVUcount; i++) {
+		mVU.analysis->markRead((pc + i) & pcMask);
+	}
+
+	a.codePC.clear();
+	a.code.clear();
+	for (u32 i = 0; i <= pcMask; i++) {
+		if (!mVU.analysis->wasRead(i)) continue;
+		a.codePC.push_back(i);
+		a.code.push_back(((u64*)mVU.regs().Micro)[i]);
+	}
+
+	a.info.resize(mVUcount);
+	for (u32 i = 0; i < mVUcount; i++) {
+		a.info[i] = mVU.prog.IRinfo.info[(pc + i) & pcMask];
+	}
+	memcpy(&a.pState, &pState, sizeof(microRegInfo));
+	memcpy(&a.pBlockState, &mVUpBlock->pState, sizeof(microRegInfo));
+	memcpy(&a.pStateEnd, &mVUregs, sizeof(microRegInfo));
+	memcpy(&a.regsTemp, &mVUregsTemp, sizeof(microTempRegInfo));
+	memcpy(a.constReg, mVUconstReg, sizeof(a.constReg));
+	a.mFC		= mFC;
+	a.startPC	= mVUstartPC;
+	a.sFlagHack = mVUsFlagHack;
+	a.count		= mVUcount;
+	a.cycles	= mVUcycles;
+	a.p			= mVU.p;
+	a.q			= mVU.q;
+}
 void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 {
 	microFlagCycles mFC;
 	u8* thisPtr = x86Ptr;
 	const u32 endCount = (((microRegInfo*)pState)->blockType) ? 1 : (mVU.microMemSize / 8);
+	const microRegInfo startState = *(microRegInfo*)pState; // pState can be mVUregs
 
 	// First Pass
 	iPC = startPC / 4;
@@ -568,100 +651,104 @@ void* mVUcompile(microVU& mVU, u32 startPC, uptr pState)
 	mVU.regAlloc->reset();          // Reset regAlloc
 	mVUinitFirstPass(mVU, pState, thisPtr);
 	mVUbranch = 0;
-	for (int branch = 0; mVUcount < endCount;) {
-		incPC(1);
-		startLoop(mVU);
-		mVUincCycles(mVU, 1);
-		mVUopU(mVU, 0);
-		mVUcheckBadOp(mVU);
-		if (curI & _Ebit_) {
-			eBitPass1(mVU, branch);
-			// VU0 end of program MAC results can be read by COP2, so best to make sure the last instance is valid
-			// Needed for State of Emergency 2 and Driving Emotion Type-S
-			if (isVU0) mVUregs.needExactMatch |= 7;
-		}
+	if (!mVUloadAnalysis(mVU, startState, mFC)) {
+		mVU.analysis->beginPass();
+		for (int branch = 0; mVUcount < endCount;) {
+			incPC(1);
+			startLoop(mVU);
+			mVUincCycles(mVU, 1);
+			mVUopU(mVU, 0);
+			mVUcheckBadOp(mVU);
+			if (curI & _Ebit_) {
+				eBitPass1(mVU, branch);
+				// VU0 end of program MAC results can be read by COP2, so best to make sure the last instance is valid
+				// Needed for State of Emergency 2 and Driving Emotion Type-S
+				if (isVU0) mVUregs.needExactMatch |= 7;
+			}
 
-		if ((curI & _Mbit_) && isVU0) {
-			if (xPC > 0)
-			{
-				incPC(-2);
-				if (!(curI & _Mbit_)) { //If the last instruction was also M-Bit we don't need to sync again
-					incPC(2);
-					mVUup.mBit = true;
-				} 
+			if ((curI & _Mbit_) && isVU0) {
+				if (xPC > 0)
+				{
+					incPC(-2);
+					if (!(curI & _Mbit_)) { //If the last instruction was also M-Bit we don't need to sync again
+						incPC(2);
+						mVUup.mBit = true;
+					} 
+					else
+						incPC(2);
+				}
 				else
-					incPC(2);
+					mVUup.mBit = true;
 			}
-			else
-				mVUup.mBit = true;
-		}
 
-		if (curI & _Ibit_) {
-			mVUlow.isNOP = true;
-			mVUup.iBit = true;
-			if (EmuConfig.Gamefixes.IbitHack) {
-				mVUsetupRange(mVU, xPC, false);
-				if (branch < 2)
-					mVUsetupRange(mVU, xPC+8, true);  // Ideally we'd do +4 but the mmx compare only works in 64bits, this should be fine
+			if (curI & _Ibit_) {
+				mVUlow.isNOP = true;
+				mVUup.iBit = true;
+				if (EmuConfig.Gamefixes.IbitHack) {
+					mVUsetupRange(mVU, xPC, false);
+					if (branch < 2)
+						mVUsetupRange(mVU, xPC+8, true);  // Ideally we'd do +4 but the mmx compare only works in 64bits, this should be fine
+				}
 			}
-		}
-		else {
-			incPC(-1);
-			mVUopL(mVU, 0);
-			incPC(1);
-		}
-		if (curI & _Dbit_) {
-			mVUup.dBit = true;
-		}
-		if (curI & _Tbit_) {
-			mVUup.tBit = true;
-		}
-		mVUsetCycles(mVU);
-		mVUinfo.readQ = mVU.q;
-		mVUinfo.writeQ = !mVU.q;
-		mVUinfo.readP = mVU.p && isVU1;
-		mVUinfo.writeP = !mVU.p && isVU1;
-		mVUcount++;
-
-		if (branch >= 2) {
-			mVUinfo.isEOB = true;
-
-			if (branch == 3) {
-				mVUinfo.isBdelay = true;
+			else {
+				incPC(-1);
+				mVUopL(mVU, 0);
+				incPC(1);
+			}
+			if (curI & _Dbit_) {
+				mVUup.dBit = true;
+			}
+			if (curI & _Tbit_) {
+				mVUup.tBit = true;
 			}
+			mVUsetCycles(mVU);
+			mVUinfo.readQ = mVU.q;
+			mVUinfo.writeQ = !mVU.q;
+			mVUinfo.readP = mVU.p && isVU1;
+			mVUinfo.writeP = !mVU.p && isVU1;
+			mVUcount++;
+
+			if (branch >= 2) {
+				mVUinfo.isEOB = true;
+
+				if (branch == 3) {
+					mVUinfo.isBdelay = true;
+				}
 
-			branchWarning(mVU);
-			break;
-		}
-		else if (branch == 1) {
-			branch = 2;
-		}
+				branchWarning(mVU);
+				break;
+			}
+			else if (branch == 1) {
+				branch = 2;
+			}
 
-		if (mVUbranch) {
-			mVUsetFlagInfo(mVU);
-			eBitWarning(mVU);
-			branch = 3;
-			mVUbranch = 0;
-		}
+			if (mVUbranch) {
+				mVUsetFlagInfo(mVU);
+				eBitWarning(mVU);
+				branch = 3;
+				mVUbranch = 0;
+			}
 
-		if (mVUup.mBit && !branch && !mVUup.eBit)
-		{
-			mVUregs.needExactMatch |= 7;
-			break;
-		}
+			if (mVUup.mBit && !branch && !mVUup.eBit)
+			{
+				mVUregs.needExactMatch |= 7;
+				break;
+			}
 
-		if (mVUinfo.isEOB)
-			break;
+			if (mVUinfo.isEOB)
+				break;
 
-		incPC(1);
-	}
+			incPC(1);
+		}
 
-	// Fix up vi15 const info for propagation through blocks
-	mVUregs.vi15 = (doConstProp && mVUconstReg[15].isValid) ? (u16)mVUconstReg[15].regValue : 0;
-	mVUregs.vi15v = (doConstProp && mVUconstReg[15].isValid) ? 1 : 0;
+		// Fix up vi15 const info for propagation through blocks
+		mVUregs.vi15 = (doConstProp && mVUconstReg[15].isValid) ? (u16)mVUconstReg[15].regValue : 0;
+		mVUregs.vi15v = (doConstProp && mVUconstReg[15].isValid) ? 1 : 0;
 
-	mVUsetFlags(mVU, mFC);           // Sets Up Flag instances
-	mVUoptimizePipeState(mVU);       // Optimize the End Pipeline State for nicer Block Linking
+		mVUsetFlags(mVU, mFC);           // Sets Up Flag instances
+		mVUoptimizePipeState(mVU);       // Optimize the End Pipeline State for nicer Block Linking
+		mVUsaveAnalysis(mVU, startState, mFC);
+	}
 	mVUdebugPrintBlocks(mVU, false); // Prints Start/End PC of blocks executed, for debugging...
 	mVUtestCycles(mVU, mFC);              // Update VU Cycles and Exit Early if Necessary
 
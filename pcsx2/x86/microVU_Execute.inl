@@ -152,16 +152,19 @@ _mVUt void mVUcleanUp() {
 	microVU& mVU = mVUx;
 
 	mVU.prog.x86ptr = x86Ptr;
+	RecCacheStats::SetUsage(vuIndex ? RecCache_VU1 : RecCache_VU0, mVU.prog.x86ptr - mVU.prog.x86start, mVU.prog.x86end - mVU.prog.x86start);
 
 	if ((xGetPtr() < mVU.prog.x86start) || (xGetPtr() >= mVU.prog.x86end)) {
 		log_cb(RETRO_LOG_DEBUG, "microVU%d: Program cache limit reached.\n", mVU.index);
+		RecCacheStats::ScopedFlush flush(vuIndex ? RecCache_VU1 : RecCache_VU0);
 		mVUreset(mVU, false);
 	}
 
 	mVU.cycles = mVU.totalCycles - mVU.cycles;
 	mVU.regs().cycle += mVU.cycles;
 
-	if (!vuIndex || !THREAD_VU1) {
+	// VU0 thread programs don't own cpuRegs, _vu0run() syncs the cycles instead
+	if (vuIndex ? !THREAD_VU1 : !THREAD_VU0) {
 		u32 cycles_passed = std::min(mVU.cycles, 3000u) * EmuConfig.Speedhacks.EECycleSkip;
 		if (cycles_passed > 0) {
 			s32 vu0_offset = VU0.cycle - cpuRegs.cycle;
@@ -171,7 +174,7 @@ _mVUt void mVUcleanUp() {
 			// So we need to adjust when VU1 skips cycles also
 			if (!vuIndex)
 				VU0.cycle = cpuRegs.cycle + vu0_offset;
-			else
+			else if (!THREAD_VU0)
 				VU0.cycle += cycles_passed;
 		}
 	}
@@ -332,6 +332,7 @@ void _mVUflagPass(mV, u32 startPC, u32 sCount, u32 found, std::vector<u32>& v) {
 	for(int branch = 0; sCount < 4; sCount += found) {
 		mVUregs.needExactMatch &= 7;
 		incPC(1);
+		mVU.analysis->markRead(iPC / 2);
 		mVUopU(mVU, 3);
 		found |= (mVUregs.needExactMatch&8)>>3;
 		mVUregs.needExactMatch &= 7;
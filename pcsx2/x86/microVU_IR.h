@@ -185,6 +185,79 @@ struct microIR {
 	u32 sFlagHack;	// Optimize out all Status flag updates if microProgram doesn't use Status flags
 };
 
+//------------------------------------------------------------------
+// Analysis Cache
+//------------------------------------------------------------------
+
+// First pass results of a block (pipeline, flag and stall info).
+// The same code is compiled again from the same pipeline state when it's part
+// of another microProgram, or after the rec cache filled up and was reset;
+// those compiles copy the results back instead of analyzing the block again.
+struct microAnalysis {
+	microRegInfo	 pState;		// Pipeline state the block was compiled from
+	microRegInfo	 pBlockState;	// State of the block it was added to the block manager as
+	microRegInfo	 pStateEnd;		// Pipeline state after the first pass
+	microTempRegInfo regsTemp;
+	microFlagCycles	 mFC;
+	microConstInfo	 constReg[16];
+	u64 hash;
+	u32 startPC;
+	u32 sFlagHack;
+	u32 count;
+	u32 cycles;
+	u32 p;
+	u32 q;
+	std::vector<u32> codePC;	// Instructions (64bit index) the first pass read...
+	std::vector<u64> code;		// ...and their contents, which must match for a reuse
+	std::vector<microOp> info;	// First pass info of each instruction in the block
+};
+
+class microAnalysisCache {
+	static const u32 cacheSize = 1024; // Entries, indexed by hash (the last one stored wins)
+	std::unique_ptr<microAnalysis> entry[cacheSize];
+	u64 readMap[0x4000/8/64];		   // Instructions read by the current first pass
+
+public:
+	u32 hits;
+	u32 misses;
+
+	microAnalysisCache() { reset(); }
+
+	void reset() {
+		for (u32 i = 0; i < cacheSize; i++)
+			entry[i].reset();
+		memzero(readMap);
+		hits = misses = 0;
+	}
+
+	static u64 getHash(u32 startPC, const microRegInfo& pState, const microRegInfo& pBlockState, u64 code) {
+		u64 hash = code ^ ((u64)startPC << 32);
+		for (u32 i = 0; i < sizeof(microRegInfo) / 8; i++) {
+			hash = (hash ^ pState.full64[i]) * 0x100000001b3ull;
+			hash = (hash ^ pBlockState.full64[i]) * 0x100000001b3ull;
+		}
+		return hash ^ (hash >> 29);
+	}
+
+	// First pass bookkeeping of the instructions it reads outside of the
+	// block itself (flag passes follow branches)
+	void beginPass()		{ memzero(readMap); }
+	void markRead(u32 pc)	{ readMap[pc / 64] |= 1ull << (pc & 63); }
+	bool wasRead(u32 pc) const { return !!(readMap[pc / 64] & (1ull << (pc & 63))); }
+
+	microAnalysis* find(u64 hash) {
+		microAnalysis* a = entry[hash & (cacheSize - 1)].get();
+		return (a && a->hash == hash) ? a : NULL;
+	}
+
+	microAnalysis& add(u64 hash) {
+		std::unique_ptr<microAnalysis>& a = entry[hash & (cacheSize - 1)];
+		if (!a) a.reset(new microAnalysis());
+		a->hash = hash;
+		return *a;
+	}
+};
+
 //------------------------------------------------------------------
 // Reg Alloc
 //------------------------------------------------------------------
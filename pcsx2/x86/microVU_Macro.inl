@@ -30,6 +30,9 @@ using namespace R5900::Dynarec;
 
 void setupMacroOp(int mode, const char* opName) {
 	printCOP2(opName);
+	// Macro ops are compiled with microVU0's IR and register allocator, which
+	// a program on the VU0 thread may be compiling with right now
+	if (THREAD_VU0) vu0Thread.WaitVU();
 	microVU0.cop2 = 1;
 	microVU0.prog.IRinfo.curPC = 0;
 	microVU0.code = cpuRegs.code;
@@ -277,6 +280,16 @@ void COP2_Interlock(bool mBitSync) {
 	}
 }
 
+// Waits for a program on the VU0 thread before a non-interlocked VU0 access,
+// registers must be flushed already
+void COP2_WaitThread() {
+	if (!THREAD_VU0) return;
+	xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
+	xForwardJZ8 skip;
+	xFastCall((void*)vu0WaitThread);
+	skip.SetTarget();
+}
+
 void TEST_FBRST_RESET(FnType_Void* resetFunct, int vuIndex) {
 	xTEST(eax, (vuIndex) ? 0x200 : 0x002);
 	xForwardJZ8 skip;
@@ -295,6 +308,7 @@ static void recCFC2() {
 	iFlushCall(FLUSH_EVERYTHING);
 
 	if (!(cpuRegs.code & 1)) {
+		COP2_WaitThread();
 		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 		xForwardJZ32 skipvuidle;
 		xMOV(eax, ptr32[&cpuRegs.cycle]);
@@ -373,7 +387,8 @@ static void recCTC2() {
 
 	iFlushCall(FLUSH_EVERYTHING);
 
-	if (!(cpuRegs.code & 1)) {;
+	if (!(cpuRegs.code & 1)) {
+		COP2_WaitThread();
 		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 		xForwardJZ32 skipvuidle;
 		xMOV(eax, ptr32[&cpuRegs.cycle]);
@@ -455,6 +470,7 @@ static void recQMFC2() {
 	iFlushCall(FLUSH_EVERYTHING);
 
 	if (!(cpuRegs.code & 1)) {
+		COP2_WaitThread();
 		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 		xForwardJZ32 skipvuidle;
 		xMOV(eax, ptr32[&cpuRegs.cycle]);
@@ -486,6 +502,7 @@ static void recQMTC2() {
 	iFlushCall(FLUSH_EVERYTHING);
 
 	if (!(cpuRegs.code & 1)) {
+		COP2_WaitThread();
 		xTEST(ptr32[&VU0.VI[REG_VPU_STAT].UL], 0x1);
 		xForwardJZ32 skipvuidle;
 		xMOV(eax, ptr32[&cpuRegs.cycle]);
@@ -577,4 +594,11 @@ void recCOP2_SPEC1() {
 
 	recCOP2SPECIAL1t[_Funct_]();
 }
-void recCOP2_SPEC2() { recCOP2SPECIAL2t[(cpuRegs.code&3)|((cpuRegs.code>>4)&0x7c)](); }
+void recCOP2_SPEC2() {
+	if (THREAD_VU0) {
+		iFlushCall(FLUSH_EVERYTHING);
+		COP2_WaitThread();
+	}
+
+	recCOP2SPECIAL2t[(cpuRegs.code&3)|((cpuRegs.code>>4)&0x7c)]();
+}
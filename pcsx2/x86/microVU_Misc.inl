@@ -272,7 +272,20 @@ static inline u32 branchAddr(const mV)
 }
 
 static void __fc mVUwaitMTVU() {
-	vu1Thread.WaitVU();
+	if (THREAD_VU0) {
+		// Called on the VU0 thread, WaitVU() and KickStart() belong to the EE.
+		// The EE kicks MTVU before it blocks on VU0, see VU0_Thread::WaitVU().
+		while (!vu1Thread.IsDone())
+			Threading::SpinWait();
+	}
+	else
+		vu1Thread.WaitVU();
+}
+
+// VPU_STAT as updated by mVU's programs, VU0 thread programs update a copy
+__fi u32* mVUvpuStat(mV)
+{
+	return (isVU0 && THREAD_VU0) ? &vu0Thread.vpuStat : &VU0.VI[REG_VPU_STAT].UL;
 }
 
 // Transforms the Address in gprReg to valid VU0/VU1 Address
@@ -668,6 +668,7 @@ void GSdxApp::Init()
 	m_current_configuration["shaderfx"]                                   = "0";
 	m_current_configuration["shaderfx_conf"]                              = "shaders/GSdx_FX_Settings.ini";
 	m_current_configuration["shaderfx_glsl"]                              = "shaders/GSdx.fx";
+	m_current_configuration["sw_selector_cache"]                          = "1";
 	m_current_configuration["TVShader"]                                   = "0";
 	m_current_configuration["upscale_multiplier"]                         = "1";
 	m_current_configuration["UserHacks"]                                  = "0";
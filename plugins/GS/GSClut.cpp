@@ -33,6 +33,10 @@ GSClut::GSClut(GSLocalMemory* mem)
 	m_clut = (uint16*)&p[0];      // 1k + 1k for mirrored area simulating wrapping memory
 	m_buff32 = (uint32*)&p[2048]; // 1k
 	m_buff64 = (uint64*)&p[4096]; // 2k
+	m_src = &p[6144];             // 1k
+	m_src_size = 0;
+	m_writes = 0;
+	m_writes_avoided = 0;
 	m_write.dirty = true;
 	m_read.dirty = true;
 
@@ -156,13 +160,97 @@ bool GSClut::WriteTest(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 	return m_write.IsDirty(TEX0, TEXCLUT);
 }
 
+int GSClut::GetWriteSource(const GIFRegTEX0& TEX0, const uint8*& src) const
+{
+	// only CSM1 loads read a fixed run of blocks, CSM2 depends on TEXCLUT and is always written
+
+	if (TEX0.CSM != 0 || m_wc[0][TEX0.CPSM][TEX0.PSM] == &GSClut::WriteCLUT_NULL)
+	{
+		return 0;
+	}
+
+	bool eight_bit = (TEX0.PSM & 0x7) == 0x3;
+
+	switch (TEX0.CPSM)
+	{
+		case PSM_PSMCT32:
+		case PSM_PSMCT24:
+			src = m_mem->BlockPtr32(0, 0, TEX0.CBP, 1);
+			return eight_bit ? 1024 : 256;
+		case PSM_PSMCT16:
+			src = m_mem->BlockPtr16(0, 0, TEX0.CBP, 1);
+			return eight_bit ? 512 : 256;
+		case PSM_PSMCT16S:
+			src = m_mem->BlockPtr16S(0, 0, TEX0.CBP, 1);
+			return eight_bit ? 512 : 256;
+	}
+
+	return 0;
+}
+
+bool GSClut::IsRedundantWrite(const GIFRegTEX0& TEX0, const uint8* src, int size) const
+{
+	// same source data expanded by the same function into the same place leaves m_clut (and the mirror) unchanged
+
+	if (size == 0 || m_src_size != size)
+	{
+		return false;
+	}
+
+	if (m_write.TEX0.CSM != 0 || m_write.TEX0.CPSM != TEX0.CPSM || m_write.TEX0.CSA != TEX0.CSA || m_write.TEX0.PSM != TEX0.PSM)
+	{
+		return false;
+	}
+
+	const GSVector4i* RESTRICT a = (const GSVector4i*)src;
+	const GSVector4i* RESTRICT b = (const GSVector4i*)m_src;
+
+	for (int i = 0, n = size / sizeof(GSVector4i); i < n; i += 4)
+	{
+		GSVector4i v = (a[i + 0] ^ b[i + 0]) | (a[i + 1] ^ b[i + 1]) | (a[i + 2] ^ b[i + 2]) | (a[i + 3] ^ b[i + 3]);
+
+		if (!v.eq(GSVector4i::zero()))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 void GSClut::Write(const GIFRegTEX0& TEX0, const GIFRegTEXCLUT& TEXCLUT)
 {
+	const uint8* src = NULL;
+
+	int size = GetWriteSource(TEX0, src);
+
+	m_writes++;
+
+	if (IsRedundantWrite(TEX0, src, size))
+	{
+		// m_read stays valid, the expanded palette does not need to be rebuilt either
+
+		m_write.TEX0 = TEX0;
+		m_write.TEXCLUT = TEXCLUT;
+		m_write.dirty = false;
+
+		m_writes_avoided++;
+
+		return;
+	}
+
 	m_write.TEX0 = TEX0;
 	m_write.TEXCLUT = TEXCLUT;
 	m_write.dirty = false;
 	m_read.dirty = true;
 
+	if (size > 0)
+	{
+		memcpy(m_src, src, size);
+	}
+
+	m_src_size = size;
+
 	(this->*m_wc[TEX0.CSM][TEX0.CPSM][TEX0.PSM])(TEX0, TEXCLUT);
 
 	// Mirror write to other half of buffer to simulate wrapping memory
@@ -40,6 +40,10 @@ class alignas(32) GSClut : public GSAlignedClass<32>
 	uint16* m_clut;
 	uint32* m_buff32;
 	uint64* m_buff64;
+	uint8* m_src;       // copy of the local memory the last CSM1 write was loaded from
+	int m_src_size;     // 0 if m_src does not describe the current contents of m_clut
+	uint32 m_writes;
+	uint32 m_writes_avoided;
 
 	struct alignas(32) WriteState
 	{
@@ -96,6 +100,9 @@ class alignas(32) GSClut : public GSAlignedClass<32>
 
 	static void Expand16(const uint16* RESTRICT src, uint32* RESTRICT dst, int w, const GIFRegTEXA& TEXA);
 
+	int GetWriteSource(const GIFRegTEX0& TEX0, const uint8*& src) const;
+	bool IsRedundantWrite(const GIFRegTEX0& TEX0, const uint8* src, int size) const;
+
 public:
 	static void InitVectors();
 
@@ -110,6 +117,10 @@ public:
 	void Read32(const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA);
 	void GetAlphaMinMax32(int& amin, int& amax);
 
+	uint32 GetWrites() const {return m_writes;}
+	uint32 GetWritesAvoided() const {return m_writes_avoided;}
+	void ResetWriteStats() {m_writes = m_writes_avoided = 0;}
+
 	uint32 operator [] (size_t i) const {return m_buff32[i];}
 
 	operator const uint32*() const  {return m_buff32;}
@@ -495,36 +495,22 @@ GSLocalMemory::~GSLocalMemory()
 		fifo_free(m_vm8, m_vmsize, 4);
 	else
 		vmfree(m_vm8, m_vmsize * 4);
-
-	for(auto &i : m_omap) delete i.second;
-	for(auto &i : m_pomap) _aligned_free(i.second);
-	for(auto &i : m_po4map) _aligned_free(i.second);
-
-	for(auto &i : m_p2tmap)
-	{
-		delete [] i.second;
-	}
 }
 
-GSOffset* GSLocalMemory::GetOffset(uint32 bp, uint32 bw, uint32 psm)
+bool GSLocalMemory::TrimPixelOffsets()
 {
-	uint32 hash = bp | (bw << 14) | (psm << 20);
-
-	auto i = m_omap.find(hash);
-
-	if(i != m_omap.end())
+	if(!CanTrimPixelOffsets())
 	{
-		return i->second;
+		return false;
 	}
 
-	GSOffset* off = new GSOffset(bp, bw, psm);
-
-	m_omap[hash] = off;
+	m_pomap.Clear();
+	m_po4map.Clear();
 
-	return off;
+	return true;
 }
 
-GSPixelOffset* GSLocalMemory::GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
+GSPixelOffset* GSLocalMemory::CreatePixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF, uint32 hash)
 {
 	uint32 fbp = FRAME.Block();
 	uint32 zbp = ZBUF.Block();
@@ -534,21 +520,7 @@ GSPixelOffset* GSLocalMemory::GetPixelOffset(const GIFRegFRAME& FRAME, const GIF
 
 	ASSERT(m_psm[fpsm].trbpp > 8 || m_psm[zpsm].trbpp > 8);
 
-	// "(psm & 0x0f) ^ ((psm & 0xf0) >> 2)" creates 4 bit unique identifiers for render target formats (only)
-
-	uint32 fpsm_hash = (fpsm & 0x0f) ^ ((fpsm & 0x30) >> 2);
-	uint32 zpsm_hash = (zpsm & 0x0f) ^ ((zpsm & 0x30) >> 2);
-
-	uint32 hash = (FRAME.FBP << 0) | (ZBUF.ZBP << 9) | (bw << 18) | (fpsm_hash << 24) | (zpsm_hash << 28);
-
-	auto it = m_pomap.find(hash);
-
-	if(it != m_pomap.end())
-	{
-		return it->second;
-	}
-
-	GSPixelOffset* off = (GSPixelOffset*)_aligned_malloc(sizeof(GSPixelOffset), 32);
+	GSPixelOffset* off = m_pomap.Insert(hash);
 
 	off->hash = hash;
 	off->fbp = fbp;
@@ -575,12 +547,10 @@ GSPixelOffset* GSLocalMemory::GetPixelOffset(const GIFRegFRAME& FRAME, const GIF
 		off->col[i].y = m_psm[zpsm].rowOffset[0][i] << zs;
 	}
 
-	m_pomap[hash] = off;
-
 	return off;
 }
 
-GSPixelOffset4* GSLocalMemory::GetPixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
+GSPixelOffset4* GSLocalMemory::CreatePixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF, uint32 hash)
 {
 	uint32 fbp = FRAME.Block();
 	uint32 zbp = ZBUF.Block();
@@ -590,21 +560,7 @@ GSPixelOffset4* GSLocalMemory::GetPixelOffset4(const GIFRegFRAME& FRAME, const G
 
 	ASSERT(m_psm[fpsm].trbpp > 8 || m_psm[zpsm].trbpp > 8);
 
-	// "(psm & 0x0f) ^ ((psm & 0xf0) >> 2)" creates 4 bit unique identifiers for render target formats (only)
-
-	uint32 fpsm_hash = (fpsm & 0x0f) ^ ((fpsm & 0x30) >> 2);
-	uint32 zpsm_hash = (zpsm & 0x0f) ^ ((zpsm & 0x30) >> 2);
-
-	uint32 hash = (FRAME.FBP << 0) | (ZBUF.ZBP << 9) | (bw << 18) | (fpsm_hash << 24) | (zpsm_hash << 28);
-
-	auto it = m_po4map.find(hash);
-
-	if(it != m_po4map.end())
-	{
-		return it->second;
-	}
-
-	GSPixelOffset4* off = (GSPixelOffset4*)_aligned_malloc(sizeof(GSPixelOffset4), 32);
+	GSPixelOffset4* off = m_po4map.Insert(hash);
 
 	off->hash = hash;
 	off->fbp = fbp;
@@ -631,24 +587,13 @@ GSPixelOffset4* GSLocalMemory::GetPixelOffset4(const GIFRegFRAME& FRAME, const G
 		off->col[i].y = m_psm[zpsm].rowOffset[0][i * 4] << zs;
 	}
 
-	m_po4map[hash] = off;
-
 	return off;
 }
 
 static bool cmp_vec2x(const GSVector2i& a, const GSVector2i& b) {return a.x < b.x;}
 
-std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
+std::vector<GSVector2i>* GSLocalMemory::CreatePage2TileMap(const GIFRegTEX0& TEX0, uint64 hash)
 {
-	uint64 hash = TEX0.u64 & 0x3ffffffffull; // TBP0 TBW PSM TW TH
-
-	auto it = m_p2tmap.find(hash);
-
-	if(it != m_p2tmap.end())
-	{
-		return it->second;
-	}
-
 	GSVector2i bs = m_psm[TEX0.PSM].bs;
 
 	int tw = std::max<int>(1 << TEX0.TW, bs.x);
@@ -672,7 +617,7 @@ std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 
 	// combine the lower 5 bits of the address into a 9:5 pointer:mask form, so the "valid bits" can be tested against an uint32 array
 
-	auto p2t = new std::vector<GSVector2i>[MAX_PAGES];
+	auto p2t = m_p2tmap.Insert(hash)->page;
 
 	for(const auto &i : tmp)
 	{
@@ -712,8 +657,6 @@ std::vector<GSVector2i>* GSLocalMemory::GetPage2TileMap(const GIFRegTEX0& TEX0)
 		std::sort(p2t[page].begin(), p2t[page].end(), cmp_vec2x);
 	}
 
-	m_p2tmap[hash] = p2t;
-
 	return p2t;
 }
 
@@ -795,7 +738,11 @@ void GSLocalMemory::WriteImageLeftRight(int l, int r, int y, int h, const uint8*
 			case PSM_PSMZ32: WritePixel32Z(x, y, *(uint32*)&src[x * 4], bp, bw); break;
 			case PSM_PSMZ16: WritePixel16Z(x, y, *(uint16*)&src[x * 2], bp, bw); break;
 			case PSM_PSMZ16S: WritePixel16SZ(x, y, *(uint16*)&src[x * 2], bp, bw); break;
-			// TODO
+			case PSM_PSMCT24: WritePixel24(x, y, *(uint32*)&src[x * 3], bp, bw); break;
+			case PSM_PSMZ24: WritePixel24Z(x, y, *(uint32*)&src[x * 3], bp, bw); break;
+			case PSM_PSMT8H: WritePixel8H(x, y, src[x], bp, bw); break;
+			case PSM_PSMT4HL: WritePixel4HL(x, y, src[x >> 1] >> ((x & 1) << 2), bp, bw); break;
+			case PSM_PSMT4HH: WritePixel4HH(x, y, src[x >> 1] >> ((x & 1) << 2), bp, bw); break;
 			default: __assume(0);
 			}
 		}
@@ -1072,179 +1019,138 @@ void GSLocalMemory::WriteImage(int& tx, int& ty, const uint8* src, int len, GIFR
 }
 
 
-static bool IsTopLeftAligned(int dsax, int tx, int ty, int bw, int bh)
+template<int psm, int trbpp>
+void GSLocalMemory::WriteImageUnpack(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
 {
-	return ((dsax & (bw-1)) == 0 && (tx & (bw-1)) == 0 && dsax == tx && (ty & (bh-1)) == 0);
-}
+	// 24/8H/4HL/4HH are unpacked into 32-bit blocks, full blocks go through GSBlock and the edges are written per pixel
 
-void GSLocalMemory::WriteImage24(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
-{
 	if(TRXREG.RRW == 0) return;
 
 	uint32 bp = BITBLTBUF.DBP;
 	uint32 bw = BITBLTBUF.DBW;
 
-	int tw = TRXPOS.DSAX + TRXREG.RRW, srcpitch = TRXREG.RRW * 3;
-	int th = len / srcpitch;
-
-	bool aligned = IsTopLeftAligned(TRXPOS.DSAX, tx, ty, 8, 8);
+	int l = (int)TRXPOS.DSAX;
+	int r = l + (int)TRXREG.RRW;
 
-	if(!aligned || (tw & 7) || (th & 7) || (len % srcpitch))
+	if(trbpp == 4 && ((l | r) & 1))
 	{
-		// TODO
+		// source nibbles would not line up with the block columns
 
 		WriteImageX(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
-	}
-	else
-	{
-		th += ty;
-
-		for(int y = ty; y < th; y += 8, src += srcpitch * 8)
-		{
-			for(int x = tx; x < tw; x += 8)
-			{
-				GSBlock::UnpackAndWriteBlock24(src + (x - tx) * 3, srcpitch, BlockPtr32(x, y, bp, bw));
-			}
-		}
 
-		ty = th;
+		return;
 	}
-}
 
-void GSLocalMemory::WriteImage8H(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
-{
-	if(TRXREG.RRW == 0) return;
-
-	uint32 bp = BITBLTBUF.DBP;
-	uint32 bw = BITBLTBUF.DBW;
+	// finish the incomplete row first
 
-	int tw = TRXPOS.DSAX + TRXREG.RRW, srcpitch = TRXREG.RRW;
-	int th = len / srcpitch;
+	if(tx != l)
+	{
+		int n = std::min(len, (r - tx) * trbpp >> 3);
+		WriteImageX(tx, ty, src, n, BITBLTBUF, TRXPOS, TRXREG);
+		src += n;
+		len -= n;
+	}
 
-	bool aligned = IsTopLeftAligned(TRXPOS.DSAX, tx, ty, 8, 8);
+	int la = (l + 7) & ~7;
+	int ra = r & ~7;
+	int srcpitch = (r - l) * trbpp >> 3;
+	int h = len / srcpitch;
 
-	if(!aligned || (tw & 7) || (th & 7) || (len % srcpitch))
+	if(ra - la >= 8 && h > 0)
 	{
-		// TODO
+		const uint8* s = &src[-l * trbpp >> 3];
 
-		WriteImageX(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
-	}
-	else
-	{
-		th += ty;
+		src += srcpitch * h;
+		len -= srcpitch * h;
 
-		for(int y = ty; y < th; y += 8, src += srcpitch * 8)
-		{
-			for(int x = tx; x < tw; x += 8)
-			{
-				GSBlock::UnpackAndWriteBlock8H(src + (x - tx), srcpitch, BlockPtr32(x, y, bp, bw));
-			}
-		}
+		int y = ty;
+		int ey = ty + h;
+		int ya = (y + 7) & ~7;
+		int eya = ey & ~7;
 
-		ty = th;
-	}
-}
+		if(ya < eya)
+		{
+			// top part
 
-void GSLocalMemory::WriteImage4HL(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
-{
-	if(TRXREG.RRW == 0) return;
+			if(y < ya)
+			{
+				WriteImageLeftRight<psm, 8, 8>(l, r, y, ya - y, s, srcpitch, BITBLTBUF);
 
-	uint32 bp = BITBLTBUF.DBP;
-	uint32 bw = BITBLTBUF.DBW;
+				s += srcpitch * (ya - y);
+			}
 
-	int tw = TRXPOS.DSAX + TRXREG.RRW, srcpitch = TRXREG.RRW / 2;
-	int th = len / srcpitch;
+			// left and right parts
 
-	bool aligned = IsTopLeftAligned(TRXPOS.DSAX, tx, ty, 8, 8);
+			if(l < la)
+			{
+				WriteImageLeftRight<psm, 8, 8>(l, la, ya, eya - ya, s, srcpitch, BITBLTBUF);
+			}
 
-	if(!aligned || (tw & 7) || (th & 7) || (len % srcpitch))
-	{
-		// TODO
+			if(ra < r)
+			{
+				WriteImageLeftRight<psm, 8, 8>(ra, r, ya, eya - ya, s, srcpitch, BITBLTBUF);
+			}
 
-		WriteImageX(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
-	}
-	else
-	{
-		th += ty;
+			// horizontally and vertically aligned part
 
-		for(int y = ty; y < th; y += 8, src += srcpitch * 8)
-		{
-			for(int x = tx; x < tw; x += 8)
+			for(y = ya; y < eya; y += 8, s += srcpitch * 8)
 			{
-				GSBlock::UnpackAndWriteBlock4HL(src + (x - tx) / 2, srcpitch, BlockPtr32(x, y, bp, bw));
+				for(int x = la; x < ra; x += 8)
+				{
+					switch(psm)
+					{
+					case PSM_PSMCT24: GSBlock::UnpackAndWriteBlock24(&s[x * 3], srcpitch, BlockPtr32(x, y, bp, bw)); break;
+					case PSM_PSMZ24: GSBlock::UnpackAndWriteBlock24(&s[x * 3], srcpitch, BlockPtr32Z(x, y, bp, bw)); break;
+					case PSM_PSMT8H: GSBlock::UnpackAndWriteBlock8H(&s[x], srcpitch, BlockPtr32(x, y, bp, bw)); break;
+					case PSM_PSMT4HL: GSBlock::UnpackAndWriteBlock4HL(&s[x >> 1], srcpitch, BlockPtr32(x, y, bp, bw)); break;
+					case PSM_PSMT4HH: GSBlock::UnpackAndWriteBlock4HH(&s[x >> 1], srcpitch, BlockPtr32(x, y, bp, bw)); break;
+					default: __assume(0);
+					}
+				}
 			}
 		}
 
-		ty = th;
-	}
-}
-
-void GSLocalMemory::WriteImage4HH(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
-{
-	if(TRXREG.RRW == 0) return;
+		// bottom part (or everything, if not even a single block row is covered)
 
-	uint32 bp = BITBLTBUF.DBP;
-	uint32 bw = BITBLTBUF.DBW;
+		if(y < ey)
+		{
+			WriteImageLeftRight<psm, 8, 8>(l, r, y, ey - y, s, srcpitch, BITBLTBUF);
+		}
 
-	int tw = TRXPOS.DSAX + TRXREG.RRW, srcpitch = TRXREG.RRW / 2;
-	int th = len / srcpitch;
+		ty = ey;
+	}
 
-	bool aligned = IsTopLeftAligned(TRXPOS.DSAX, tx, ty, 8, 8);
+	// the rest
 
-	if(!aligned || (tw & 7) || (th & 7) || (len % srcpitch))
+	if(len > 0)
 	{
-		// TODO
-
 		WriteImageX(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
 	}
-	else
-	{
-		th += ty;
-
-		for(int y = ty; y < th; y += 8, src += srcpitch * 8)
-		{
-			for(int x = tx; x < tw; x += 8)
-			{
-				GSBlock::UnpackAndWriteBlock4HH(src + (x - tx) / 2, srcpitch, BlockPtr32(x, y, bp, bw));
-			}
-		}
-
-		ty = th;
-	}
 }
 
-void GSLocalMemory::WriteImage24Z(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+void GSLocalMemory::WriteImage24(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
 {
-	if(TRXREG.RRW == 0) return;
-
-	uint32 bp = BITBLTBUF.DBP;
-	uint32 bw = BITBLTBUF.DBW;
-
-	int tw = TRXPOS.DSAX + TRXREG.RRW, srcpitch = TRXREG.RRW * 3;
-	int th = len / srcpitch;
-
-	bool aligned = IsTopLeftAligned(TRXPOS.DSAX, tx, ty, 8, 8);
+	WriteImageUnpack<PSM_PSMCT24, 24>(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+}
 
-	if(!aligned || (tw & 7) || (th & 7) || (len % srcpitch))
-	{
-		// TODO
+void GSLocalMemory::WriteImage8H(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	WriteImageUnpack<PSM_PSMT8H, 8>(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+}
 
-		WriteImageX(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
-	}
-	else
-	{
-		th += ty;
+void GSLocalMemory::WriteImage4HL(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	WriteImageUnpack<PSM_PSMT4HL, 4>(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+}
 
-		for(int y = ty; y < th; y += 8, src += srcpitch * 8)
-		{
-			for(int x = tx; x < tw; x += 8)
-			{
-				GSBlock::UnpackAndWriteBlock24(src + (x - tx) * 3, srcpitch, BlockPtr32Z(x, y, bp, bw));
-			}
-		}
+void GSLocalMemory::WriteImage4HH(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	WriteImageUnpack<PSM_PSMT4HH, 4>(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
+}
 
-		ty = th;
-	}
+void GSLocalMemory::WriteImage24Z(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
+{
+	WriteImageUnpack<PSM_PSMZ24, 24>(tx, ty, src, len, BITBLTBUF, TRXPOS, TRXREG);
 }
 
 void GSLocalMemory::WriteImageX(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG)
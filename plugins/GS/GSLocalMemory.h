@@ -82,6 +82,151 @@ struct GSPixelOffset4
 	uint32 fbp, zbp, fpsm, zpsm, bw;
 };
 
+struct GSPage2TileMap
+{
+	std::vector<GSVector2i> page[MAX_PAGES];
+};
+
+// Open addressed cache for the offset tables, keyed by the packed (bp, bw, psm) value.
+// Entries are constructed in chunks which are only given back together by Clear(),
+// so the returned pointers stay valid until then.
+
+template<class KEY, class T, int CHUNK> class GSOffsetCache
+{
+	struct Slot {KEY key; T* value;};
+
+	static const size_t m_stride = (sizeof(T) + 31) & ~31;
+
+	Slot* m_slots;
+	uint32 m_mask;
+	uint32 m_count;
+	std::vector<uint8*> m_chunks;
+	uint32 m_chunk_pos;
+	KEY m_last_key;
+	T* m_last;
+
+	__forceinline static uint32 Hash(KEY key)
+	{
+		return (uint32)(((uint64)key * 0x9e3779b97f4a7c15ull) >> 32);
+	}
+
+	void Grow()
+	{
+		Slot* slots = m_slots;
+		uint32 size = m_mask + 1;
+
+		m_mask = size * 2 - 1;
+		m_slots = (Slot*)calloc(m_mask + 1, sizeof(Slot));
+
+		for(uint32 i = 0; i < size; i++)
+		{
+			if(slots[i].value != NULL)
+			{
+				uint32 j = Hash(slots[i].key) & m_mask;
+
+				while(m_slots[j].value != NULL) j = (j + 1) & m_mask;
+
+				m_slots[j] = slots[i];
+			}
+		}
+
+		free(slots);
+	}
+
+public:
+	GSOffsetCache()
+		: m_mask(63)
+		, m_count(0)
+		, m_chunk_pos(CHUNK)
+		, m_last_key(0)
+		, m_last(NULL)
+	{
+		m_slots = (Slot*)calloc(m_mask + 1, sizeof(Slot));
+	}
+
+	~GSOffsetCache()
+	{
+		Clear();
+
+		free(m_slots);
+	}
+
+	__forceinline T* Find(KEY key)
+	{
+		if(m_last != NULL && m_last_key == key)
+		{
+			return m_last;
+		}
+
+		for(uint32 i = Hash(key) & m_mask; m_slots[i].value != NULL; i = (i + 1) & m_mask)
+		{
+			if(m_slots[i].key == key)
+			{
+				m_last_key = key;
+				m_last = m_slots[i].value;
+
+				return m_last;
+			}
+		}
+
+		return NULL;
+	}
+
+	template<class... Args> T* Insert(KEY key, Args&&... args)
+	{
+		if(m_chunk_pos == CHUNK)
+		{
+			m_chunks.push_back((uint8*)_aligned_malloc(m_stride * CHUNK, 32));
+			m_chunk_pos = 0;
+		}
+
+		T* value = ::new(m_chunks.back() + m_stride * m_chunk_pos++) T(std::forward<Args>(args)...);
+
+		if((m_count + 1) * 2 > m_mask + 1)
+		{
+			Grow();
+		}
+
+		uint32 i = Hash(key) & m_mask;
+
+		while(m_slots[i].value != NULL) i = (i + 1) & m_mask;
+
+		m_slots[i].key = key;
+		m_slots[i].value = value;
+		m_count++;
+
+		m_last_key = key;
+		m_last = value;
+
+		return value;
+	}
+
+	uint32 GetCount() const {return m_count;}
+
+	void Clear()
+	{
+		for(uint32 i = 0; i <= m_mask; i++)
+		{
+			if(m_slots[i].value != NULL)
+			{
+				m_slots[i].value->~T();
+			}
+		}
+
+		for(uint8* chunk : m_chunks)
+		{
+			_aligned_free(chunk);
+		}
+
+		memset(m_slots, 0, (m_mask + 1) * sizeof(Slot));
+
+		m_chunks.clear();
+		m_chunk_pos = CHUNK;
+		m_count = 0;
+		m_last = NULL;
+	}
+};
+
 class GSLocalMemory : public GSAlignedClass<32>
 {
 public:
@@ -176,19 +321,70 @@ protected:
 
 	//
 
-	std::unordered_map<uint32, GSOffset*> m_omap;
-	std::unordered_map<uint32, GSPixelOffset*> m_pomap;
-	std::unordered_map<uint32, GSPixelOffset4*> m_po4map;
-	std::unordered_map<uint64, std::vector<GSVector2i>*> m_p2tmap;
+	GSOffsetCache<uint32, GSOffset, 16> m_omap;
+	GSOffsetCache<uint32, GSPixelOffset, 8> m_pomap;
+	GSOffsetCache<uint32, GSPixelOffset4, 8> m_po4map;
+	GSOffsetCache<uint64, GSPage2TileMap, 8> m_p2tmap;
+
+	GSPixelOffset* CreatePixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF, uint32 hash);
+	GSPixelOffset4* CreatePixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF, uint32 hash);
+	std::vector<GSVector2i>* CreatePage2TileMap(const GIFRegTEX0& TEX0, uint64 hash);
 
 public:
+	// frame/zbuf pixel offsets are only referenced by the drawing contexts, they can be dropped between frames
+	enum {MAX_PIXEL_OFFSETS = 64};
+
 	GSLocalMemory();
 	virtual ~GSLocalMemory();
 
-	GSOffset* GetOffset(uint32 bp, uint32 bw, uint32 psm);
-	GSPixelOffset* GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF);
-	GSPixelOffset4* GetPixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF);
-	std::vector<GSVector2i>* GetPage2TileMap(const GIFRegTEX0& TEX0);
+	__forceinline GSOffset* GetOffset(uint32 bp, uint32 bw, uint32 psm)
+	{
+		uint32 hash = bp | (bw << 14) | (psm << 20);
+
+		GSOffset* off = m_omap.Find(hash);
+
+		return off != NULL ? off : m_omap.Insert(hash, bp, bw, psm);
+	}
+
+	__forceinline GSPixelOffset* GetPixelOffset(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
+	{
+		uint32 hash = PixelOffsetHash(FRAME, ZBUF);
+
+		GSPixelOffset* off = m_pomap.Find(hash);
+
+		return off != NULL ? off : CreatePixelOffset(FRAME, ZBUF, hash);
+	}
+
+	__forceinline GSPixelOffset4* GetPixelOffset4(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
+	{
+		uint32 hash = PixelOffsetHash(FRAME, ZBUF);
+
+		GSPixelOffset4* off = m_po4map.Find(hash);
+
+		return off != NULL ? off : CreatePixelOffset4(FRAME, ZBUF, hash);
+	}
+
+	__forceinline std::vector<GSVector2i>* GetPage2TileMap(const GIFRegTEX0& TEX0)
+	{
+		uint64 hash = TEX0.u64 & 0x3ffffffffull; // TBP0 TBW PSM TW TH
+
+		GSPage2TileMap* p2t = m_p2tmap.Find(hash);
+
+		return p2t != NULL ? p2t->page : CreatePage2TileMap(TEX0, hash);
+	}
+
+	bool CanTrimPixelOffsets() const {return m_pomap.GetCount() + m_po4map.GetCount() > MAX_PIXEL_OFFSETS;}
+	bool TrimPixelOffsets();
+
+	__forceinline static uint32 PixelOffsetHash(const GIFRegFRAME& FRAME, const GIFRegZBUF& ZBUF)
+	{
+		// "(psm & 0x0f) ^ ((psm & 0xf0) >> 2)" creates 4 bit unique identifiers for render target formats (only)
+
+		uint32 fpsm_hash = (FRAME.PSM & 0x0f) ^ ((FRAME.PSM & 0x30) >> 2);
+		uint32 zpsm_hash = (ZBUF.PSM & 0x0f) ^ ((ZBUF.PSM & 0x30) >> 2);
+
+		return (FRAME.FBP << 0) | (ZBUF.ZBP << 9) | (FRAME.FBW << 18) | (fpsm_hash << 24) | (zpsm_hash << 28);
+	}
 
 	// address
 
@@ -866,6 +1062,9 @@ public:
 	template<int psm, int bsx, int bsy, int trbpp>
 	void WriteImage(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
 
+	template<int psm, int trbpp>
+	void WriteImageUnpack(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
+
 	void WriteImage24(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
 	void WriteImage8H(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
 	void WriteImage4HL(int& tx, int& ty, const uint8* src, int len, GIFRegBITBLTBUF& BITBLTBUF, GIFRegTRXPOS& TRXPOS, GIFRegTRXREG& TRXREG);
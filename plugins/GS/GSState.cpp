@@ -51,6 +51,7 @@ GSState::GSState()
 	m_mipmap                = theApp.GetConfigI("mipmap");
 	m_NTSC_Saturation       = theApp.GetConfigB("NTSC_Saturation");
 	m_clut_load_before_draw = theApp.GetConfigB("clut_load_before_draw");
+	m_merged_state_writes   = 0;
 
 
 	// this hack will be called only once while system init
@@ -251,6 +252,24 @@ void GSState::Reset()
 	m_texflush = true;
 }
 
+bool GSState::TrimPixelOffsets()
+{
+	// caller must make sure no draw is still reading the old tables
+
+	if(!m_mem.TrimPixelOffsets())
+	{
+		return false;
+	}
+
+	for(size_t i = 0; i < 2; i++)
+	{
+		m_env.CTXT[i].offset.fzb = m_mem.GetPixelOffset(m_env.CTXT[i].FRAME, m_env.CTXT[i].ZBUF);
+		m_env.CTXT[i].offset.fzb4 = m_mem.GetPixelOffset4(m_env.CTXT[i].FRAME, m_env.CTXT[i].ZBUF);
+	}
+
+	return true;
+}
+
 void GSState::ResetHandlers()
 {
 	for(size_t i = 0; i < countof(m_fpGIFPackedRegHandlers); i++)
@@ -753,6 +772,24 @@ void GSState::GIFRegHandlerNull(const GIFReg* RESTRICT r)
 	// ASSERT(0);
 }
 
+// Most registers are only read by the draw for some primitive settings, like
+// TEX1 without texture mapping or FOGCOL without fogging. Changing them does
+// not need to end the queued primitives, which are then drawn as one batch.
+// Except for the draw skipping hacks, which count draws and test the texture
+// registers (even without texture mapping) as they are when the batch is drawn.
+
+__forceinline void GSState::FlushIfUsed(bool used)
+{
+	if(used || m_gsc || m_skip > 0 || m_userhacks_skipdraw > 0)
+	{
+		Flush();
+	}
+	else if(m_index.tail > 0)
+	{
+		m_merged_state_writes++;
+	}
+}
+
 __forceinline void GSState::ApplyPRIM(uint32 prim)
 {
 	// ASSERT(r->PRIM.PRIM < 7);
@@ -879,10 +916,14 @@ template<int i> void GSState::ApplyTEX0(GIFRegTEX0& TEX0)
 
 	uint64 mask = 0x1f78001c3fffffffull; // TBP0 TBW PSM TW TCC TFX CPSM CSA
 
-	if(wt || PRIM->CTXT == i && ((TEX0.u64 ^ m_env.CTXT[i].TEX0.u64) & mask))
+	if(wt)
 	{
 		Flush();
 	}
+	else if(PRIM->CTXT == i && ((TEX0.u64 ^ m_env.CTXT[i].TEX0.u64) & mask))
+	{
+		FlushIfUsed(PRIM->TME);
+	}
 
 	TEX0.CPSM &= 0xa; // 1010b
 
@@ -1031,7 +1072,7 @@ template<int i> void GSState::GIFRegHandlerCLAMP(const GIFReg* RESTRICT r)
 	GL_REG("CLAMP_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
 	if(PRIM->CTXT == i && r->CLAMP != m_env.CTXT[i].CLAMP)
 	{
-		Flush();
+		FlushIfUsed(PRIM->TME);
 	}
 
 	m_env.CTXT[i].CLAMP = (GSVector4i)r->CLAMP;
@@ -1051,7 +1092,7 @@ template<int i> void GSState::GIFRegHandlerTEX1(const GIFReg* RESTRICT r)
 	GL_REG("TEX1_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
 	if(PRIM->CTXT == i && r->TEX1 != m_env.CTXT[i].TEX1)
 	{
-		Flush();
+		FlushIfUsed(PRIM->TME);
 	}
 
 	m_env.CTXT[i].TEX1 = (GSVector4i)r->TEX1;
@@ -1156,7 +1197,7 @@ template<int i> void GSState::GIFRegHandlerMIPTBP1(const GIFReg* RESTRICT r)
 	GL_REG("MIPTBP1_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
 	if(PRIM->CTXT == i && r->MIPTBP1 != m_env.CTXT[i].MIPTBP1)
 	{
-		Flush();
+		FlushIfUsed(PRIM->TME);
 	}
 
 	m_env.CTXT[i].MIPTBP1 = (GSVector4i)r->MIPTBP1;
@@ -1167,7 +1208,7 @@ template<int i> void GSState::GIFRegHandlerMIPTBP2(const GIFReg* RESTRICT r)
 	GL_REG("MIPTBP2_%d = 0x%x_%x", i, r->u32[1], r->u32[0]);
 	if(PRIM->CTXT == i && r->MIPTBP2 != m_env.CTXT[i].MIPTBP2)
 	{
-		Flush();
+		FlushIfUsed(PRIM->TME);
 	}
 
 	m_env.CTXT[i].MIPTBP2 = (GSVector4i)r->MIPTBP2;
@@ -1178,7 +1219,7 @@ void GSState::GIFRegHandlerTEXA(const GIFReg* RESTRICT r)
 	GL_REG("TEXA = 0x%x_%x", r->u32[1], r->u32[0]);
 	if(r->TEXA != m_env.TEXA)
 	{
-		Flush();
+		FlushIfUsed(PRIM->TME);
 	}
 
 	m_env.TEXA = (GSVector4i)r->TEXA;
@@ -1189,7 +1230,7 @@ void GSState::GIFRegHandlerFOGCOL(const GIFReg* RESTRICT r)
 	GL_REG("FOGCOL = 0x%x_%x", r->u32[1], r->u32[0]);
 	if(r->FOGCOL != m_env.FOGCOL)
 	{
-		Flush();
+		FlushIfUsed(PRIM->FGE);
 	}
 
 	m_env.FOGCOL = (GSVector4i)r->FOGCOL;
@@ -1235,7 +1276,7 @@ void GSState::GIFRegHandlerDIMX(const GIFReg* RESTRICT r)
 
 	if(r->DIMX != m_env.DIMX)
 	{
-		Flush();
+		FlushIfUsed(m_env.DTHE.DTHE);
 
 		update = true;
 	}
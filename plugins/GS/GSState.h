@@ -83,6 +83,7 @@ class GSState : public GSAlignedClass<32>
 
 	template<int i> void ApplyTEX0(GIFRegTEX0& TEX0);
 	void ApplyPRIM(uint32 prim);
+	void FlushIfUsed(bool used);
 
 	void GIFRegHandlerNull(const GIFReg* RESTRICT r);
 	void GIFRegHandlerPRIM(const GIFReg* RESTRICT r);
@@ -185,6 +186,8 @@ protected:
 		size_t tail;
 	} m_index;
 
+	uint32 m_merged_state_writes; // state changes which did not split the queued draw
+
 	void UpdateContext();
 	void UpdateScissor();
 
@@ -247,6 +250,7 @@ public:
 	float GetTvRefreshRate();
 
 	virtual void Reset();
+	bool TrimPixelOffsets();
 	void Flush();
 	void FlushPrim();
 	void FlushWrite();
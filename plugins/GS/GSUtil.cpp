@@ -24,6 +24,8 @@
 
 #ifdef _WIN32
 #include "Renderers/DX11/GSDevice11.h"
+#else
+#include <sys/stat.h> // mkdir
 #endif
 
 static class GSUtilMaps
@@ -147,6 +149,17 @@ CRCHackLevel GSUtil::GetRecommendedCRCHackLevel(GSRendererType type)
 	return type == GSRendererType::OGL_HW ? CRCHackLevel::Partial : CRCHackLevel::Full;
 }
 
+void GSmkdir(const char* dir)
+{
+#ifdef _WIN32
+	CreateDirectoryA(dir, NULL);
+#else
+	int err = mkdir(dir, 0777);
+	if (err && errno != EEXIST)
+		fprintf(stderr, "Failed to create directory: %s\n", dir);
+#endif
+}
+
 const char* psm_str(int psm)
 {
 	switch(psm) {
@@ -45,4 +45,6 @@ public:
 	static CRCHackLevel GetRecommendedCRCHackLevel(GSRendererType type);
 };
 
+void GSmkdir(const char* dir);
+
 const char* psm_str(int psm);
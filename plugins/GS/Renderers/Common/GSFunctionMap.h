@@ -101,30 +101,51 @@ class GSCodeGeneratorFunctionMap : public GSFunctionMap<KEY, VALUE>
 	void* m_param;
 	std::unordered_map<uint64, VALUE> m_cgmap;
 	GSCodeBuffer m_cb;
+	uint64 m_ondemand;
+
+	VALUE Generate(KEY key)
+	{
+		CG* cg = new CG(m_param, key, 
+				m_cb.GetBuffer(8192), 8192);
+
+		m_cb.ReleaseBuffer(cg->getSize());
+
+		VALUE ret = m_cgmap[key] = (VALUE)cg->getCode();
+
+		delete cg;
+
+		return ret;
+	}
 
 public:
 	GSCodeGeneratorFunctionMap(const char* name, void* param)
-		: m_param(param) { }
+		: m_param(param), m_ondemand(0) { }
 	~GSCodeGeneratorFunctionMap() { }
 
 	VALUE GetDefaultFunction(KEY key)
 	{
-		VALUE ret = NULL;
-
 		auto i = m_cgmap.find(key);
 
 		if(i != m_cgmap.end())
 			return i->second;
 
-		CG* cg = new CG(m_param, key, 
-				m_cb.GetBuffer(8192), 8192);
-
-		m_cb.ReleaseBuffer(cg->getSize());
+		m_ondemand++;
 
-		ret = m_cgmap[key] = (VALUE)cg->getCode();
+		return Generate(key);
+	}
 
-		delete cg;
+	// Compiles a function ahead of its first use, it is not counted as an on-demand compile.
+	void Warmup(KEY key)
+	{
+		if(m_cgmap.find(key) == m_cgmap.end())
+			Generate(key);
+	}
 
-		return ret;
+	void GetKeys(std::vector<uint64>& keys) const
+	{
+		for(const auto& i : m_cgmap) keys.push_back(i.first);
 	}
+
+	uint64 GetOnDemandCount() const {return m_ondemand;}
+	void ResetOnDemandCount() {m_ondemand = 0;}
 };
@@ -277,6 +277,20 @@ void GSRenderer::VSync(int field)
 {
 	Flush();
 
+#ifndef NDEBUG
+	if(m_mem.m_clut.GetWritesAvoided() > 0)
+		log_cb(RETRO_LOG_DEBUG, "CLUT: %u of %u writes avoided\n", m_mem.m_clut.GetWritesAvoided(), m_mem.m_clut.GetWrites());
+#endif
+
+	m_mem.m_clut.ResetWriteStats();
+
+#ifndef NDEBUG
+	if(m_merged_state_writes > 0)
+		log_cb(RETRO_LOG_DEBUG, "GS: %u state changes merged into queued draws\n", m_merged_state_writes);
+#endif
+
+	m_merged_state_writes = 0;
+
 	if(!Merge(field ? 1 : 0))
 		return;
 
@@ -156,366 +156,421 @@ void GSVertexTrace::Update(const void* vertex, const uint32* index, int v_count,
 	}
 }
 
-template<GS_PRIM_CLASS primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
-void GSVertexTrace::FindMinMax(const void* vertex, const uint32* index, int count)
-{
-	const GSDrawingContext* context = m_state->m_context;
+// One primitive per 128 bit lane, VI/VF are either GSVector4i/GSVector4 (a single primitive)
+// or GSVector8i/GSVector8 (primitive i in the low lane and i + n in the high lane).
 
-	int n = 1;
+template<class VI> __forceinline static VI LoadVertex(const GSVertex* RESTRICT v, const uint32* RESTRICT index, int i, int n, int j);
 
-	switch(primclass)
-	{
-	case GS_POINT_CLASS:
-		n = 1;
-		break;
-	case GS_LINE_CLASS:
-	case GS_SPRITE_CLASS:
-		n = 2;
-		break;
-	case GS_TRIANGLE_CLASS:
-		n = 3;
-		break;
-	}
-
-	GSVector4 tmin  = s_minmax.xxxx();
-	GSVector4 tmax  = s_minmax.yyyy();
-	GSVector4i cmin = GSVector4i::xffffffff();
-	GSVector4i cmax = GSVector4i::zero();
-
-	#if _M_SSE >= 0x401
-
-	GSVector4i pmin = GSVector4i::xffffffff();
-	GSVector4i pmax = GSVector4i::zero();
+template<> __forceinline GSVector4i LoadVertex(const GSVertex* RESTRICT v, const uint32* RESTRICT index, int i, int n, int j)
+{
+	return GSVector4i(v[index[i]].m[j]);
+}
 
-	#else
+#if _M_SSE >= 0x501
 
-	GSVector4 pmin = s_minmax.xxxx();
-	GSVector4 pmax = s_minmax.yyyy();
-	
-	#endif
+template<> __forceinline GSVector8i LoadVertex(const GSVertex* RESTRICT v, const uint32* RESTRICT index, int i, int n, int j)
+{
+	return GSVector8i(v[index[i]].m[j], v[index[i + n]].m[j]);
+}
 
-	const GSVertex* RESTRICT v = (GSVertex*)vertex;
+#endif
 
-	for(int i = 0; i < count; i += n)
+template<GS_PRIM_CLASS primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq, class VI, class VF, class VP>
+__forceinline static void FindMinMaxPrim(const GSVertex* RESTRICT v, const uint32* RESTRICT index, int i, int n, VF& tmin, VF& tmax, VI& cmin, VI& cmax, VP& pmin, VP& pmax)
+{
+	if(primclass == GS_POINT_CLASS)
 	{
-		if(primclass == GS_POINT_CLASS)
-		{
-			GSVector4i c(v[index[i]].m[0]);
+		VI c = LoadVertex<VI>(v, index, i, n, 0);
 
-			if(color)
-			{
-				cmin = cmin.min_u8(c);
-				cmax = cmax.max_u8(c);
-			}
+		if(color)
+		{
+			cmin = cmin.min_u8(c);
+			cmax = cmax.max_u8(c);
+		}
 
-			if(tme)
+		if(tme)
+		{
+			if(!fst)
 			{
-				if(!fst)
-				{
-					GSVector4 stq = GSVector4::cast(c);
-
-					GSVector4 q = stq.wwww();
+				VF stq = VF::cast(c);
 
-					if (accurate_stq)
-						stq = (stq.xyww() / q).xyww(q);
-					else
-						stq = (stq.xyww() * q.rcpnr()).xyww(q);
+				VF q = stq.wwww();
 
-					tmin = tmin.min(stq);
-					tmax = tmax.max(stq);
-				}
+				if (accurate_stq)
+					stq = (stq.xyww() / q).xyww(q);
 				else
-				{
-					GSVector4i uv(v[index[i]].m[1]);
+					stq = (stq.xyww() * q.rcpnr()).xyww(q);
+
+				tmin = tmin.min(stq);
+				tmax = tmax.max(stq);
+			}
+			else
+			{
+				VI uv = LoadVertex<VI>(v, index, i, n, 1);
 
-					GSVector4 st = GSVector4(uv.uph16()).xyxy();
+				VF st = VF(uv.uph16()).xyxy();
 
-					tmin = tmin.min(st);
-					tmax = tmax.max(st);
-				}
+				tmin = tmin.min(st);
+				tmax = tmax.max(st);
 			}
+		}
 
-			GSVector4i xyzf(v[index[i]].m[1]);
+		VI xyzf = LoadVertex<VI>(v, index, i, n, 1);
 
-			GSVector4i xy = xyzf.upl16();
-			GSVector4i z = xyzf.yyyy();
+		VI xy = xyzf.upl16();
+		VI z = xyzf.yyyy();
 
-			#if _M_SSE >= 0x401
+		#if _M_SSE >= 0x401
 
-			GSVector4i p = xy.blend16<0xf0>(z.uph32(xyzf));
+		VI p = xy.template blend16<0xf0>(z.uph32(xyzf));
 
-			pmin = pmin.min_u32(p);
-			pmax = pmax.max_u32(p);
+		pmin = pmin.min_u32(p);
+		pmax = pmax.max_u32(p);
 
-			#else
+		#else
 
-			GSVector4 p = GSVector4(xy.upl64(z.srl32(1).upl32(xyzf.wwww())));
+		VP p = VP(xy.upl64(z.srl32(1).upl32(xyzf.wwww())));
 
-			pmin = pmin.min(p);
-			pmax = pmax.max(p);
+		pmin = pmin.min(p);
+		pmax = pmax.max(p);
 
-			#endif
-		}
-		else if(primclass == GS_LINE_CLASS)
+		#endif
+	}
+	else if(primclass == GS_LINE_CLASS)
+	{
+		VI c0 = LoadVertex<VI>(v, index, i + 0, n, 0);
+		VI c1 = LoadVertex<VI>(v, index, i + 1, n, 0);
+
+		if(color)
 		{
-			GSVector4i c0(v[index[i + 0]].m[0]);
-			GSVector4i c1(v[index[i + 1]].m[0]);
+			if(iip)
+			{
+				cmin = cmin.min_u8(c0.min_u8(c1));
+				cmax = cmax.max_u8(c0.max_u8(c1));
+			}
+			else
+			{
+				cmin = cmin.min_u8(c1);
+				cmax = cmax.max_u8(c1);
+			}
+		}
 
-			if(color)
+		if(tme)
+		{
+			if(!fst)
 			{
-				if(iip)
+				VF stq0 = VF::cast(c0);
+				VF stq1 = VF::cast(c1);
+
+				if(accurate_stq)
 				{
-					cmin = cmin.min_u8(c0.min_u8(c1));
-					cmax = cmax.max_u8(c0.max_u8(c1));
+					VF q = stq0.wwww(stq1);
+
+					stq0 = (stq0.xyww() / q.xxxx()).xyww(stq0);
+					stq1 = (stq1.xyww() / q.zzzz()).xyww(stq1);
 				}
 				else
 				{
-					cmin = cmin.min_u8(c1);
-					cmax = cmax.max_u8(c1);
+					VF q = stq0.wwww(stq1).rcpnr();
+
+					stq0 = (stq0.xyww() * q.xxxx()).xyww(stq0);
+					stq1 = (stq1.xyww() * q.zzzz()).xyww(stq1);
 				}
-			}
 
-			if(tme)
+				tmin = tmin.min(stq0.min(stq1));
+				tmax = tmax.max(stq0.max(stq1));
+			}
+			else
 			{
-				if(!fst)
-				{
-					GSVector4 stq0 = GSVector4::cast(c0);
-					GSVector4 stq1 = GSVector4::cast(c1);
-
-					if(accurate_stq)
-					{
-						GSVector4 q = stq0.wwww(stq1);
-
-						stq0 = (stq0.xyww() / q.xxxx()).xyww(stq0);
-						stq1 = (stq1.xyww() / q.zzzz()).xyww(stq1);
-					}
-					else
-					{
-						GSVector4 q = stq0.wwww(stq1).rcpnr();
-
-						stq0 = (stq0.xyww() * q.xxxx()).xyww(stq0);
-						stq1 = (stq1.xyww() * q.zzzz()).xyww(stq1);
-					}
-
-					tmin = tmin.min(stq0.min(stq1));
-					tmax = tmax.max(stq0.max(stq1));
-				}
-				else
-				{
-					GSVector4i uv0(v[index[i + 0]].m[1]);
-					GSVector4i uv1(v[index[i + 1]].m[1]);
+				VI uv0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+				VI uv1 = LoadVertex<VI>(v, index, i + 1, n, 1);
 
-					GSVector4 st0 = GSVector4(uv0.uph16()).xyxy();
-					GSVector4 st1 = GSVector4(uv1.uph16()).xyxy();
+				VF st0 = VF(uv0.uph16()).xyxy();
+				VF st1 = VF(uv1.uph16()).xyxy();
 
-					tmin = tmin.min(st0.min(st1));
-					tmax = tmax.max(st0.max(st1));
-				}
+				tmin = tmin.min(st0.min(st1));
+				tmax = tmax.max(st0.max(st1));
 			}
+		}
 
-			GSVector4i xyzf0(v[index[i + 0]].m[1]);
-			GSVector4i xyzf1(v[index[i + 1]].m[1]);
+		VI xyzf0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+		VI xyzf1 = LoadVertex<VI>(v, index, i + 1, n, 1);
 
-			GSVector4i xy0 = xyzf0.upl16();
-			GSVector4i z0 = xyzf0.yyyy();
-			GSVector4i xy1 = xyzf1.upl16();
-			GSVector4i z1 = xyzf1.yyyy();
+		VI xy0 = xyzf0.upl16();
+		VI z0 = xyzf0.yyyy();
+		VI xy1 = xyzf1.upl16();
+		VI z1 = xyzf1.yyyy();
 
-			#if _M_SSE >= 0x401
+		#if _M_SSE >= 0x401
 
-			GSVector4i p0 = xy0.blend16<0xf0>(z0.uph32(xyzf0));
-			GSVector4i p1 = xy1.blend16<0xf0>(z1.uph32(xyzf1));
+		VI p0 = xy0.template blend16<0xf0>(z0.uph32(xyzf0));
+		VI p1 = xy1.template blend16<0xf0>(z1.uph32(xyzf1));
 
-			pmin = pmin.min_u32(p0.min_u32(p1));
-			pmax = pmax.max_u32(p0.max_u32(p1));
+		pmin = pmin.min_u32(p0.min_u32(p1));
+		pmax = pmax.max_u32(p0.max_u32(p1));
 
-			#else
+		#else
 
-			GSVector4 p0 = GSVector4(xy0.upl64(z0.srl32(1).upl32(xyzf0.wwww())));
-			GSVector4 p1 = GSVector4(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
+		VP p0 = VP(xy0.upl64(z0.srl32(1).upl32(xyzf0.wwww())));
+		VP p1 = VP(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
 
-			pmin = pmin.min(p0.min(p1));
-			pmax = pmax.max(p0.max(p1));
+		pmin = pmin.min(p0.min(p1));
+		pmax = pmax.max(p0.max(p1));
 
-			#endif
-		}
-		else if(primclass == GS_TRIANGLE_CLASS)
+		#endif
+	}
+	else if(primclass == GS_TRIANGLE_CLASS)
+	{
+		VI c0 = LoadVertex<VI>(v, index, i + 0, n, 0);
+		VI c1 = LoadVertex<VI>(v, index, i + 1, n, 0);
+		VI c2 = LoadVertex<VI>(v, index, i + 2, n, 0);
+
+		if(color)
 		{
-			GSVector4i c0(v[index[i + 0]].m[0]);
-			GSVector4i c1(v[index[i + 1]].m[0]);
-			GSVector4i c2(v[index[i + 2]].m[0]);
+			if(iip)
+			{
+				cmin = cmin.min_u8(c2).min_u8(c0.min_u8(c1));
+				cmax = cmax.max_u8(c2).max_u8(c0.max_u8(c1));
+			}
+			else
+			{
+				cmin = cmin.min_u8(c2);
+				cmax = cmax.max_u8(c2);
+			}
+		}
 
-			if(color)
+		if(tme)
+		{
+			if(!fst)
 			{
-				if(iip)
+				VF stq0 = VF::cast(c0);
+				VF stq1 = VF::cast(c1);
+				VF stq2 = VF::cast(c2);
+
+				if(accurate_stq)
 				{
-					cmin = cmin.min_u8(c2).min_u8(c0.min_u8(c1));
-					cmax = cmax.max_u8(c2).max_u8(c0.max_u8(c1));
+					VF q = stq0.wwww(stq1).xzww(stq2);
+
+					stq0 = (stq0.xyww() / q.xxxx()).xyww(stq0);
+					stq1 = (stq1.xyww() / q.yyyy()).xyww(stq1);
+					stq2 = (stq2.xyww() / q.zzzz()).xyww(stq2);
 				}
 				else
 				{
-					cmin = cmin.min_u8(c2);
-					cmax = cmax.max_u8(c2);
+					VF q = stq0.wwww(stq1).xzww(stq2).rcpnr();
+
+					stq0 = (stq0.xyww() * q.xxxx()).xyww(stq0);
+					stq1 = (stq1.xyww() * q.yyyy()).xyww(stq1);
+					stq2 = (stq2.xyww() * q.zzzz()).xyww(stq2);
 				}
-			}
 
-			if(tme)
+				tmin = tmin.min(stq2).min(stq0.min(stq1));
+				tmax = tmax.max(stq2).max(stq0.max(stq1));
+			}
+			else
 			{
-				if(!fst)
-				{
-					GSVector4 stq0 = GSVector4::cast(c0);
-					GSVector4 stq1 = GSVector4::cast(c1);
-					GSVector4 stq2 = GSVector4::cast(c2);
-
-					if(accurate_stq)
-					{
-						GSVector4 q = stq0.wwww(stq1).xzww(stq2);
-
-						stq0 = (stq0.xyww() / q.xxxx()).xyww(stq0);
-						stq1 = (stq1.xyww() / q.yyyy()).xyww(stq1);
-						stq2 = (stq2.xyww() / q.zzzz()).xyww(stq2);
-					}
-					else
-					{
-						GSVector4 q = stq0.wwww(stq1).xzww(stq2).rcpnr();
-
-						stq0 = (stq0.xyww() * q.xxxx()).xyww(stq0);
-						stq1 = (stq1.xyww() * q.yyyy()).xyww(stq1);
-						stq2 = (stq2.xyww() * q.zzzz()).xyww(stq2);
-					}
-
-					tmin = tmin.min(stq2).min(stq0.min(stq1));
-					tmax = tmax.max(stq2).max(stq0.max(stq1));
-				}
-				else
-				{
-					GSVector4i uv0(v[index[i + 0]].m[1]);
-					GSVector4i uv1(v[index[i + 1]].m[1]);
-					GSVector4i uv2(v[index[i + 2]].m[1]);
+				VI uv0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+				VI uv1 = LoadVertex<VI>(v, index, i + 1, n, 1);
+				VI uv2 = LoadVertex<VI>(v, index, i + 2, n, 1);
 
-					GSVector4 st0 = GSVector4(uv0.uph16()).xyxy();
-					GSVector4 st1 = GSVector4(uv1.uph16()).xyxy();
-					GSVector4 st2 = GSVector4(uv2.uph16()).xyxy();
+				VF st0 = VF(uv0.uph16()).xyxy();
+				VF st1 = VF(uv1.uph16()).xyxy();
+				VF st2 = VF(uv2.uph16()).xyxy();
 
-					tmin = tmin.min(st2).min(st0.min(st1));
-					tmax = tmax.max(st2).max(st0.max(st1));
-				}
+				tmin = tmin.min(st2).min(st0.min(st1));
+				tmax = tmax.max(st2).max(st0.max(st1));
 			}
+		}
 
-			GSVector4i xyzf0(v[index[i + 0]].m[1]);
-			GSVector4i xyzf1(v[index[i + 1]].m[1]);
-			GSVector4i xyzf2(v[index[i + 2]].m[1]);
+		VI xyzf0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+		VI xyzf1 = LoadVertex<VI>(v, index, i + 1, n, 1);
+		VI xyzf2 = LoadVertex<VI>(v, index, i + 2, n, 1);
 
-			GSVector4i xy0 = xyzf0.upl16();
-			GSVector4i z0 = xyzf0.yyyy();
-			GSVector4i xy1 = xyzf1.upl16();
-			GSVector4i z1 = xyzf1.yyyy();
-			GSVector4i xy2 = xyzf2.upl16();
-			GSVector4i z2 = xyzf2.yyyy();
+		VI xy0 = xyzf0.upl16();
+		VI z0 = xyzf0.yyyy();
+		VI xy1 = xyzf1.upl16();
+		VI z1 = xyzf1.yyyy();
+		VI xy2 = xyzf2.upl16();
+		VI z2 = xyzf2.yyyy();
 
-			#if _M_SSE >= 0x401
+		#if _M_SSE >= 0x401
 
-			GSVector4i p0 = xy0.blend16<0xf0>(z0.uph32(xyzf0));
-			GSVector4i p1 = xy1.blend16<0xf0>(z1.uph32(xyzf1));
-			GSVector4i p2 = xy2.blend16<0xf0>(z2.uph32(xyzf2));
+		VI p0 = xy0.template blend16<0xf0>(z0.uph32(xyzf0));
+		VI p1 = xy1.template blend16<0xf0>(z1.uph32(xyzf1));
+		VI p2 = xy2.template blend16<0xf0>(z2.uph32(xyzf2));
 
-			pmin = pmin.min_u32(p2).min_u32(p0.min_u32(p1));
-			pmax = pmax.max_u32(p2).max_u32(p0.max_u32(p1));
+		pmin = pmin.min_u32(p2).min_u32(p0.min_u32(p1));
+		pmax = pmax.max_u32(p2).max_u32(p0.max_u32(p1));
 
-			#else
+		#else
 
-			GSVector4 p0 = GSVector4(xy0.upl64(z0.srl32(1).upl32(xyzf0.wwww())));
-			GSVector4 p1 = GSVector4(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
-			GSVector4 p2 = GSVector4(xy2.upl64(z2.srl32(1).upl32(xyzf2.wwww())));
+		VP p0 = VP(xy0.upl64(z0.srl32(1).upl32(xyzf0.wwww())));
+		VP p1 = VP(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
+		VP p2 = VP(xy2.upl64(z2.srl32(1).upl32(xyzf2.wwww())));
 
-			pmin = pmin.min(p2).min(p0.min(p1));
-			pmax = pmax.max(p2).max(p0.max(p1));
+		pmin = pmin.min(p2).min(p0.min(p1));
+		pmax = pmax.max(p2).max(p0.max(p1));
 
-			#endif
-		}
-		else if(primclass == GS_SPRITE_CLASS)
+		#endif
+	}
+	else if(primclass == GS_SPRITE_CLASS)
+	{
+		VI c0 = LoadVertex<VI>(v, index, i + 0, n, 0);
+		VI c1 = LoadVertex<VI>(v, index, i + 1, n, 0);
+
+		if(color)
 		{
-			GSVector4i c0(v[index[i + 0]].m[0]);
-			GSVector4i c1(v[index[i + 1]].m[0]);
+			if(iip)
+			{
+				cmin = cmin.min_u8(c0.min_u8(c1));
+				cmax = cmax.max_u8(c0.max_u8(c1));
+			}
+			else
+			{
+				cmin = cmin.min_u8(c1);
+				cmax = cmax.max_u8(c1);
+			}
+		}
 
-			if(color)
+		if(tme)
+		{
+			if(!fst)
 			{
-				if(iip)
+				VF stq0 = VF::cast(c0);
+				VF stq1 = VF::cast(c1);
+
+				if(accurate_stq)
 				{
-					cmin = cmin.min_u8(c0.min_u8(c1));
-					cmax = cmax.max_u8(c0.max_u8(c1));
+					VF q = stq1.wwww();
+
+					stq0 = (stq0.xyww() / q).xyww(stq1);
+					stq1 = (stq1.xyww() / q).xyww(stq1);
 				}
 				else
 				{
-					cmin = cmin.min_u8(c1);
-					cmax = cmax.max_u8(c1);
+					VF q = stq1.wwww().rcpnr();
+
+					stq0 = (stq0.xyww() * q).xyww(stq1);
+					stq1 = (stq1.xyww() * q).xyww(stq1);
 				}
-			}
 
-			if(tme)
+				tmin = tmin.min(stq0.min(stq1));
+				tmax = tmax.max(stq0.max(stq1));
+			}
+			else
 			{
-				if(!fst)
-				{
-					GSVector4 stq0 = GSVector4::cast(c0);
-					GSVector4 stq1 = GSVector4::cast(c1);
-
-					if(accurate_stq)
-					{
-						GSVector4 q = stq1.wwww();
-
-						stq0 = (stq0.xyww() / q).xyww(stq1);
-						stq1 = (stq1.xyww() / q).xyww(stq1);
-					}
-					else
-					{
-						GSVector4 q = stq1.wwww().rcpnr();
-
-						stq0 = (stq0.xyww() * q).xyww(stq1);
-						stq1 = (stq1.xyww() * q).xyww(stq1);
-					}
-
-					tmin = tmin.min(stq0.min(stq1));
-					tmax = tmax.max(stq0.max(stq1));
-				}
-				else
-				{
-					GSVector4i uv0(v[index[i + 0]].m[1]);
-					GSVector4i uv1(v[index[i + 1]].m[1]);
+				VI uv0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+				VI uv1 = LoadVertex<VI>(v, index, i + 1, n, 1);
 
-					GSVector4 st0 = GSVector4(uv0.uph16()).xyxy();
-					GSVector4 st1 = GSVector4(uv1.uph16()).xyxy();
+				VF st0 = VF(uv0.uph16()).xyxy();
+				VF st1 = VF(uv1.uph16()).xyxy();
 
-					tmin = tmin.min(st0.min(st1));
-					tmax = tmax.max(st0.max(st1));
-				}
+				tmin = tmin.min(st0.min(st1));
+				tmax = tmax.max(st0.max(st1));
 			}
+		}
+
+		VI xyzf0 = LoadVertex<VI>(v, index, i + 0, n, 1);
+		VI xyzf1 = LoadVertex<VI>(v, index, i + 1, n, 1);
+
+		VI xy0 = xyzf0.upl16();
+		VI z0 = xyzf0.yyyy();
+		VI xy1 = xyzf1.upl16();
+		VI z1 = xyzf1.yyyy();
 
-			GSVector4i xyzf0(v[index[i + 0]].m[1]);
-			GSVector4i xyzf1(v[index[i + 1]].m[1]);
+		#if _M_SSE >= 0x401
 
-			GSVector4i xy0 = xyzf0.upl16();
-			GSVector4i z0 = xyzf0.yyyy();
-			GSVector4i xy1 = xyzf1.upl16();
-			GSVector4i z1 = xyzf1.yyyy();
+		VI p0 = xy0.template blend16<0xf0>(z0.uph32(xyzf1));
+		VI p1 = xy1.template blend16<0xf0>(z1.uph32(xyzf1));
 
-			#if _M_SSE >= 0x401
+		pmin = pmin.min_u32(p0.min_u32(p1));
+		pmax = pmax.max_u32(p0.max_u32(p1));
 
-			GSVector4i p0 = xy0.blend16<0xf0>(z0.uph32(xyzf1));
-			GSVector4i p1 = xy1.blend16<0xf0>(z1.uph32(xyzf1));
+		#else
 
-			pmin = pmin.min_u32(p0.min_u32(p1));
-			pmax = pmax.max_u32(p0.max_u32(p1));
+		VP p0 = VP(xy0.upl64(z0.srl32(1).upl32(xyzf1.wwww())));
+		VP p1 = VP(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
 
-			#else
+		pmin = pmin.min(p0.min(p1));
+		pmax = pmax.max(p0.max(p1));
 
-			GSVector4 p0 = GSVector4(xy0.upl64(z0.srl32(1).upl32(xyzf1.wwww())));
-			GSVector4 p1 = GSVector4(xy1.upl64(z1.srl32(1).upl32(xyzf1.wwww())));
+		#endif
+	}
+}
 
-			pmin = pmin.min(p0.min(p1));
-			pmax = pmax.max(p0.max(p1));
+template<GS_PRIM_CLASS primclass, uint32 iip, uint32 tme, uint32 fst, uint32 color, uint32 accurate_stq>
+void GSVertexTrace::FindMinMax(const void* vertex, const uint32* index, int count)
+{
+	const GSDrawingContext* context = m_state->m_context;
+
+	int n = 1;
 
-			#endif
+	switch(primclass)
+	{
+	case GS_POINT_CLASS:
+		n = 1;
+		break;
+	case GS_LINE_CLASS:
+	case GS_SPRITE_CLASS:
+		n = 2;
+		break;
+	case GS_TRIANGLE_CLASS:
+		n = 3;
+		break;
+	}
+
+	GSVector4 tmin  = s_minmax.xxxx();
+	GSVector4 tmax  = s_minmax.yyyy();
+	GSVector4i cmin = GSVector4i::xffffffff();
+	GSVector4i cmax = GSVector4i::zero();
+
+	#if _M_SSE >= 0x401
+
+	GSVector4i pmin = GSVector4i::xffffffff();
+	GSVector4i pmax = GSVector4i::zero();
+
+	#else
+
+	GSVector4 pmin = s_minmax.xxxx();
+	GSVector4 pmax = s_minmax.yyyy();
+	
+	#endif
+
+	const GSVertex* RESTRICT v = (GSVertex*)vertex;
+
+	int i = 0;
+
+	#if _M_SSE >= 0x501
+
+	// two primitives per iteration, the lanes are folded into the 128 bit accumulators afterwards
+
+	if(count >= n * 8)
+	{
+		GSVector8 tmin8 = GSVector8(FLT_MAX);
+		GSVector8 tmax8 = GSVector8(-FLT_MAX);
+		GSVector8i cmin8 = GSVector8i::xffffffff();
+		GSVector8i cmax8 = GSVector8i::zero();
+		GSVector8i pmin8 = GSVector8i::xffffffff();
+		GSVector8i pmax8 = GSVector8i::zero();
+
+		for(; i + n * 2 <= count; i += n * 2)
+		{
+			FindMinMaxPrim<primclass, iip, tme, fst, color, accurate_stq>(v, index, i, n, tmin8, tmax8, cmin8, cmax8, pmin8, pmax8);
 		}
+
+		tmin = tmin.min(tmin8.extract<0>()).min(tmin8.extract<1>());
+		tmax = tmax.max(tmax8.extract<0>()).max(tmax8.extract<1>());
+		cmin = cmin.min_u8(cmin8.extract<0>()).min_u8(cmin8.extract<1>());
+		cmax = cmax.max_u8(cmax8.extract<0>()).max_u8(cmax8.extract<1>());
+		pmin = pmin.min_u32(pmin8.extract<0>()).min_u32(pmin8.extract<1>());
+		pmax = pmax.max_u32(pmax8.extract<0>()).max_u32(pmax8.extract<1>());
+	}
+
+	#endif
+
+	for(; i < count; i += n)
+	{
+		FindMinMaxPrim<primclass, iip, tme, fst, color, accurate_stq>(v, index, i, n, tmin, tmax, cmin, cmax, pmin, pmax);
 	}
 
 	// FIXME/WARNING. A division by 2 is done on the depth. I suspect to avoid
@@ -378,6 +378,8 @@ void GSRendererHW::VSync(int field)
 		m_reset = false;
 	}
 
+	TrimPixelOffsets();
+
 	GSRenderer::VSync(field);
 
 	m_tc->IncAge();
@@ -113,6 +113,33 @@ void GSDrawScanline::EndDraw(uint64 frame, int actual, int total)
 {
 }
 
+void GSDrawScanline::Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp)
+{
+	for(uint64 key : ds)
+	{
+		m_ds_map.Warmup(key);
+	}
+
+	for(uint64 key : sp)
+	{
+		m_sp_map.Warmup(key);
+	}
+
+	m_ds_map.ResetOnDemandCount();
+	m_sp_map.ResetOnDemandCount();
+}
+
+void GSDrawScanline::GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const
+{
+	m_ds_map.GetKeys(ds);
+	m_sp_map.GetKeys(sp);
+}
+
+uint64 GSDrawScanline::GetOnDemandCompiles() const
+{
+	return m_ds_map.GetOnDemandCount() + m_sp_map.GetOnDemandCount();
+}
+
 #ifndef ENABLE_JIT_RASTERIZER
 
 void GSDrawScanline::SetupPrim(const GSVertexSW* vertex, const uint32* index, const GSVertexSW& dscan)
@@ -70,6 +70,10 @@ public:
 	void BeginDraw(const GSRasterizerData* data);
 	void EndDraw(uint64 frame, int actual, int total);
 
+	void Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp);
+	void GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const;
+	uint64 GetOnDemandCompiles() const;
+
 	void DrawRect(const GSVector4i& r, const GSVertexSW& v);
 
 #ifndef ENABLE_JIT_RASTERIZER
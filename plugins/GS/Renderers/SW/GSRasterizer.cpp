@@ -1195,3 +1195,51 @@ int GSRasterizerList::GetPixels(bool reset)
 
 	return pixels;
 }
+
+void GSRasterizerList::Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp)
+{
+	Sync();
+
+	// every rasterizer owns its code buffers, generate them side by side
+
+	std::vector<std::thread> threads;
+
+	for(auto& r : m_r)
+	{
+		GSRasterizer* p = r.get();
+
+		threads.emplace_back([p, &ds, &sp]() { p->Warmup(ds, sp); });
+	}
+
+	for(auto& t : threads)
+	{
+		t.join();
+	}
+}
+
+void GSRasterizerList::GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const
+{
+	// each rasterizer only saw the draws that touched its scanlines
+
+	for(const auto& r : m_r)
+	{
+		r->GetSelectors(ds, sp);
+	}
+
+	std::sort(ds.begin(), ds.end());
+	ds.erase(std::unique(ds.begin(), ds.end()), ds.end());
+	std::sort(sp.begin(), sp.end());
+	sp.erase(std::unique(sp.begin(), sp.end()), sp.end());
+}
+
+uint64 GSRasterizerList::GetOnDemandCompiles() const
+{
+	uint64 count = 0;
+
+	for(const auto& r : m_r)
+	{
+		count += r->GetOnDemandCompiles();
+	}
+
+	return count;
+}
@@ -84,6 +84,12 @@ public:
 	virtual void BeginDraw(const GSRasterizerData* data) = 0;
 	virtual void EndDraw(uint64 frame, int actual, int total) = 0;
 
+	// selector warm-up, ds/sp are the keys of the draw scanline and setup prim functions
+
+	virtual void Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp) {}
+	virtual void GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const {}
+	virtual uint64 GetOnDemandCompiles() const {return 0;}
+
 #ifdef ENABLE_JIT_RASTERIZER
 
 	__forceinline void SetupPrim(const GSVertexSW* vertex, const uint32* index, const GSVertexSW& dscan) {m_sp(vertex, index, dscan);}
@@ -113,6 +119,11 @@ public:
 	virtual void Sync() = 0;
 	virtual bool IsSynced() const = 0;
 	virtual int GetPixels(bool reset = true) = 0;
+
+	// must be called while synced, the keys of all rasterizers are merged
+	virtual void Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp) = 0;
+	virtual void GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const = 0;
+	virtual uint64 GetOnDemandCompiles() const = 0;
 };
 
 class alignas(32) GSRasterizer : public IRasterizer
@@ -167,6 +178,9 @@ public:
 	void Sync() {}
 	bool IsSynced() const {return true;}
 	int GetPixels(bool reset);
+	void Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp) {m_ds->Warmup(ds, sp);}
+	void GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const {m_ds->GetSelectors(ds, sp);}
+	uint64 GetOnDemandCompiles() const {return m_ds->GetOnDemandCompiles();}
 };
 
 class GSRasterizerList : public IRasterizer
@@ -213,4 +227,7 @@ public:
 	void Sync();
 	bool IsSynced() const;
 	int GetPixels(bool reset);
+	void Warmup(const std::vector<uint64>& ds, const std::vector<uint64>& sp);
+	void GetSelectors(std::vector<uint64>& ds, std::vector<uint64>& sp) const;
+	uint64 GetOnDemandCompiles() const;
 };
@@ -21,6 +21,7 @@
 
 #include "../../stdafx.h"
 #include "GSRendererSW.h"
+#include "options_tools.h"
 
 GSVector4 GSRendererSW::m_pos_scale;
 #if _M_SSE >= 0x501
@@ -38,6 +39,7 @@ void GSRendererSW::InitVectors()
 
 GSRendererSW::GSRendererSW(int threads)
 	: m_fzb(NULL)
+	, m_selector_crc(0)
 {
 	m_nativeres = true; // ignore ini, sw is always native
 
@@ -77,10 +79,14 @@ GSRendererSW::GSRendererSW(int threads)
 		m_userhacks_auto_flush = true;
 		ResetHandlers();
 	}
+
+	m_selector_cache = theApp.GetConfigB("sw_selector_cache");
 }
 
 GSRendererSW::~GSRendererSW()
 {
+	SaveSelectorCache();
+
 	delete m_tc;
 
 	for(size_t i = 0; i < countof(m_texture); i++)
@@ -102,10 +108,148 @@ void GSRendererSW::Reset()
 	GSRenderer::Reset();
 }
 
+void GSRendererSW::SetGameCRC(uint32 crc, int options)
+{
+	GSRenderer::SetGameCRC(crc, options);
+
+	if(crc == m_selector_crc)
+		return;
+
+	SaveSelectorCache();
+	LoadSelectorCache(crc);
+}
+
+std::string GSRendererSW::GetSelectorCachePath(uint32 crc) const
+{
+	const char* save_dir = nullptr;
+
+	if(!environ_cb(RETRO_ENVIRONMENT_GET_SAVE_DIRECTORY, &save_dir) || save_dir == nullptr)
+		return std::string();
+
+	std::string dir = format("%s/pcsx2/gs", save_dir);
+
+	GSmkdir(dir.c_str());
+
+	return format("%s/sw_%08X_%x.sel", dir.c_str(), crc, _M_SSE);
+}
+
+// file layout: magic, version, ds count, sp count, followed by the ds and sp selector keys
+
+static const uint32 s_selector_cache_magic = 0x43534753; // GSSC
+static const uint32 s_selector_cache_version = 1;
+
+void GSRendererSW::LoadSelectorCache(uint32 crc)
+{
+	m_selector_crc = crc;
+
+	if(!m_selector_cache || crc == 0)
+		return;
+
+	std::vector<uint64> ds;
+	std::vector<uint64> sp;
+
+	std::string path = GetSelectorCachePath(crc);
+
+	if(FILE* fp = path.empty() ? NULL : fopen(path.c_str(), "rb"))
+	{
+		uint32 header[4] = {};
+
+		bool ok = fread(header, sizeof(header), 1, fp) == 1
+			&& header[0] == s_selector_cache_magic
+			&& header[1] == s_selector_cache_version
+			&& header[2] <= 0x10000 && header[3] <= 0x10000;
+
+		if(ok)
+		{
+			ds.resize(header[2]);
+			sp.resize(header[3]);
+
+			ok = fread(ds.data(), sizeof(uint64), ds.size(), fp) == ds.size()
+				&& fread(sp.data(), sizeof(uint64), sp.size(), fp) == sp.size();
+		}
+
+		fclose(fp);
+
+		if(!ok)
+		{
+			log_cb(RETRO_LOG_WARN, "GS: ignoring invalid scanline selector cache %s\n", path.c_str());
+
+			ds.clear();
+			sp.clear();
+		}
+	}
+
+	// also restarts the on-demand compile counters when there is nothing to warm up
+
+	m_rl->Warmup(ds, sp);
+
+	if(!ds.empty() || !sp.empty())
+	{
+		log_cb(RETRO_LOG_INFO, "GS: warmed up %d scanline and %d setup selectors for %08X\n", (int)ds.size(), (int)sp.size(), crc);
+	}
+}
+
+void GSRendererSW::SaveSelectorCache()
+{
+	if(!m_selector_cache || m_selector_crc == 0)
+		return;
+
+	Sync(-1);
+
+	std::vector<uint64> ds;
+	std::vector<uint64> sp;
+
+	m_rl->GetSelectors(ds, sp);
+
+	log_cb(RETRO_LOG_INFO, "GS: %llu scanline functions were compiled on demand after warm-up\n", (unsigned long long)m_rl->GetOnDemandCompiles());
+
+	if(ds.empty() && sp.empty())
+		return;
+
+	std::string path = GetSelectorCachePath(m_selector_crc);
+
+	FILE* fp = path.empty() ? NULL : fopen(path.c_str(), "wb");
+
+	if(fp == NULL)
+		return;
+
+	uint32 header[4] = {s_selector_cache_magic, s_selector_cache_version, (uint32)ds.size(), (uint32)sp.size()};
+
+	bool ok = fwrite(header, sizeof(header), 1, fp) == 1
+		&& fwrite(ds.data(), sizeof(uint64), ds.size(), fp) == ds.size()
+		&& fwrite(sp.data(), sizeof(uint64), sp.size(), fp) == sp.size();
+
+	fclose(fp);
+
+	if(!ok)
+	{
+		remove(path.c_str());
+	}
+}
+
 void GSRendererSW::VSync(int field)
 {
-	Sync(0); // IncAge might delete a cached texture in use
+	// The rasterizer threads keep drawing across the vsync while the next frame
+	// is parsed, they are only waited for when something they may still read is
+	// about to be freed. GetOutput() waits for the displayed pages by itself.
+
+	if(m_mem.CanTrimPixelOffsets())
+	{
+		Sync(0);
+
+		if(TrimPixelOffsets())
+		{
+			m_fzb = NULL;
+		}
+	}
+
 	GSRenderer::VSync(field);
+
+	if(m_tc->HasExpired())
+	{
+		Sync(0); // IncAge might delete a cached texture in use
+	}
+
 	m_tc->IncAge();
 }
 
@@ -121,8 +265,6 @@ void GSRendererSW::ResetDevice()
 
 GSTexture* GSRendererSW::GetOutput(int i, int& y_offset)
 {
-	Sync(1);
-
 	const GSRegDISPFB& DISPFB = m_regs->DISP[i].DISPFB;
 
 	int w = DISPFB.FBW * 64;
@@ -138,7 +280,15 @@ GSTexture* GSRendererSW::GetOutput(int i, int& y_offset)
 
 		const GSLocalMemory::psm_t& psm = GSLocalMemory::m_psm[DISPFB.PSM];
 
-		(m_mem.*psm.rtx)(m_mem.GetOffset(DISPFB.Block(), DISPFB.FBW, DISPFB.PSM), r.ralign<Align_Outside>(psm.bs), m_output, pitch, m_env.TEXA);
+		GSOffset* off = m_mem.GetOffset(DISPFB.Block(), DISPFB.FBW, DISPFB.PSM);
+
+		r = r.ralign<Align_Outside>(psm.bs);
+
+		// only wait for the draws still rendering to the displayed buffer
+
+		SyncTargetPages(off, r, 1);
+
+		(m_mem.*psm.rtx)(off, r, m_output, pitch, m_env.TEXA);
 
 		m_texture[i]->Update(r, m_output, pitch);
 	}
@@ -486,17 +636,22 @@ void GSRendererSW::InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GS
 
 void GSRendererSW::InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut)
 {
+	SyncTargetPages(m_mem.GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM), r, 7);
+}
+
+void GSRendererSW::SyncTargetPages(GSOffset* off, const GSVector4i& r, int reason)
+{
+	// wait for the queued draws only if one of them renders to these pages
+
 	if(!m_rl->IsSynced())
 	{
-		GSOffset* off = m_mem.GetOffset(BITBLTBUF.SBP, BITBLTBUF.SBW, BITBLTBUF.SPSM);
-
 		off->GetPages(r, m_tmp_pages);
 
 		for(uint32* RESTRICT p = m_tmp_pages; *p != GSOffset::EOP; p++)
 		{
 			if(m_fzb_pages[*p])
 			{
-				Sync(7);
+				Sync(reason);
 
 				break;
 			}
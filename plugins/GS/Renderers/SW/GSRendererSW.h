@@ -90,6 +90,7 @@ protected:
 	void Sync(int reason);
 	void InvalidateVideoMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r);
 	void InvalidateLocalMem(const GIFRegBITBLTBUF& BITBLTBUF, const GSVector4i& r, bool clut = false);
+	void SyncTargetPages(GSOffset* off, const GSVector4i& r, int reason);
 
 	void UsePages(const uint32* pages, const int type);
 	void ReleasePages(const uint32* pages, const int type);
@@ -99,6 +100,17 @@ protected:
 
 	bool GetScanlineGlobalData(SharedData* data);
 
+	// scanline selectors used by a game are saved per crc and compiled again ahead of time on the next run
+
+	bool m_selector_cache;
+	uint32 m_selector_crc;
+
+	std::string GetSelectorCachePath(uint32 crc) const;
+	void LoadSelectorCache(uint32 crc);
+	void SaveSelectorCache();
+
+	void SetGameCRC(uint32 crc, int options);
+
 public:
 	static void InitVectors();
 
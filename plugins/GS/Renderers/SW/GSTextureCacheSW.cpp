@@ -144,6 +144,21 @@ void GSTextureCacheSW::IncAge()
 	}
 }
 
+bool GSTextureCacheSW::HasExpired() const
+{
+	// true if the next IncAge() deletes a texture
+
+	for(const Texture* t : m_textures)
+	{
+		if(t->m_age >= 10)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 //
 
 GSTextureCacheSW::Texture::Texture(GSState* state, uint32 tw0, const GIFRegTEX0& TEX0, const GIFRegTEXA& TEXA)
@@ -73,4 +73,5 @@ public:
 
 	void RemoveAll();
 	void IncAge();
+	bool HasExpired() const;
 };